@@ -37,6 +37,14 @@ Allocator::DepthOutput Allocator::depthResources(const Engine & engine) {
   if (!(properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eDepthStencilAttachment))
     throw std::runtime_error("groot-engine: invalid depth format");
 
+  vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eDepthStencilAttachment;
+  if (engine.m_settings.culling_mode == OcclusionCulling) {
+    if (!(properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImage))
+      throw std::runtime_error("groot-engine: depth format cannot be sampled");
+
+    usage |= vk::ImageUsageFlagBits::eSampled;
+  }
+
   vk::raii::DeviceMemory memory = nullptr;
   vk::raii::Image image = nullptr;
   vk::raii::ImageView view = nullptr;
@@ -53,7 +61,7 @@ Allocator::DepthOutput Allocator::depthResources(const Engine & engine) {
     .arrayLayers  = 1,
     .samples      = vk::SampleCountFlagBits::e1,
     .tiling       = vk::ImageTiling::eOptimal,
-    .usage        = vk::ImageUsageFlagBits::eDepthStencilAttachment,
+    .usage        = usage,
     .sharingMode  = vk::SharingMode::eExclusive
   });
 
@@ -78,6 +86,33 @@ Allocator::DepthOutput Allocator::depthResources(const Engine & engine) {
   return { std::move(memory), std::move(image), std::move(view) };
 }
 
+Allocator::ImageOutput Allocator::imageResources(
+  const Engine& engine,
+  const vk::ImageCreateInfo& info,
+  vk::ImageAspectFlags aspect
+) {
+  vk::raii::DeviceMemory memory = nullptr;
+  vk::raii::Image image = engine.m_context.device().createImage(info);
+  vk::raii::ImageView view = nullptr;
+
+  vk::MemoryRequirements requirements = image.getMemoryRequirements();
+  memory = allocate(engine, requirements.size, requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+  image.bindMemory(memory, 0);
+
+  view = engine.m_context.device().createImageView(vk::ImageViewCreateInfo{
+    .image            = image,
+    .viewType         = vk::ImageViewType::e2D,
+    .format           = info.format,
+    .subresourceRange = {
+      .aspectMask = aspect,
+      .levelCount = info.mipLevels,
+      .layerCount = info.arrayLayers
+    }
+  });
+
+  return { std::move(memory), std::move(image), std::move(view) };
+}
+
 Allocator::FenceOutput Allocator::fences(const Engine& engine, unsigned int count, bool signaled) {
   std::vector<vk::raii::Fence> fences;
 
@@ -99,26 +134,49 @@ Allocator::SemaphoreOutput Allocator::semaphores(const Engine& engine, unsigned
   return std::move(semaphores);
 }
 
-Allocator::DescriptorOutput Allocator::descriptorPool(const Engine& engine, const vk::raii::DescriptorSetLayout& setLayout) {
-  vk::DescriptorPoolSize storagePool{
-    .type             = vk::DescriptorType::eStorageBuffer,
-    .descriptorCount  = engine.m_settings.buffer_mode
-  };
+Allocator::DescriptorOutput Allocator::descriptorPool(
+  const Engine& engine,
+  const vk::raii::DescriptorSetLayout& setLayout,
+  unsigned int count,
+  unsigned int descriptors
+) {
+  return descriptorPool(engine, setLayout, count, {
+    vk::DescriptorPoolSize{
+      .type             = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = count * descriptors
+    }
+  });
+}
 
+Allocator::DescriptorOutput Allocator::descriptorPool(
+  const Engine& engine,
+  const vk::raii::DescriptorSetLayout& setLayout,
+  unsigned int count,
+  const std::vector<vk::DescriptorPoolSize>& poolSizes,
+  vk::DescriptorPoolCreateFlags flags,
+  unsigned int variableCount
+) {
   vk::raii::DescriptorPool pool = engine.m_context.device().createDescriptorPool(vk::DescriptorPoolCreateInfo{
-    .flags          = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
-    .maxSets        = engine.m_settings.buffer_mode,
-    .poolSizeCount  = 1,
-    .pPoolSizes     = &storagePool
+    .flags          = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet | flags,
+    .maxSets        = count,
+    .poolSizeCount  = static_cast<unsigned int>(poolSizes.size()),
+    .pPoolSizes     = poolSizes.data()
   });
 
   std::vector<vk::DescriptorSetLayout> layouts;
-  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i)
+  for (unsigned int i = 0; i < count; ++i)
     layouts.emplace_back(*setLayout);
 
+  std::vector<unsigned int> variableCounts(count, variableCount);
+  vk::DescriptorSetVariableDescriptorCountAllocateInfo ci_variable{
+    .descriptorSetCount = count,
+    .pDescriptorCounts  = variableCounts.data()
+  };
+
   vk::raii::DescriptorSets sets(engine.m_context.device(), vk::DescriptorSetAllocateInfo{
+    .pNext              = variableCount > 0 ? &ci_variable : nullptr,
     .descriptorPool     = pool,
-    .descriptorSetCount = engine.m_settings.buffer_mode,
+    .descriptorSetCount = count,
     .pSetLayouts        = layouts.data()
   });
 
@@ -0,0 +1,148 @@
+#include "src/include/bounds.hpp"
+
+#if defined(__SSE__) || defined(_M_X64)
+  #include <immintrin.h>
+#elif defined(__ARM_NEON)
+  #include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+namespace ge {
+
+Bounds::Bounds(const vec3& minimum, const vec3& maximum) : min(minimum), max(maximum) {
+  center = (min + max) * 0.5f;
+  radius = (max - center).magnitude();
+}
+
+Bounds Bounds::compute(const std::vector<Vertex>& vertices) {
+  return compute(vertices.data(), vertices.size());
+}
+
+Bounds Bounds::compute(const Vertex * vertices, unsigned int count) {
+  if (count == 0) return Bounds();
+
+  alignas(16) float lo[4];
+  alignas(16) float hi[4];
+
+#if defined(__SSE__) || defined(_M_X64)
+  __m128 minimum = _mm_load_ps(&vertices[0].m_position.x);
+  __m128 maximum = minimum;
+
+  for (unsigned int i = 1; i < count; ++i) {
+    __m128 position = _mm_load_ps(&vertices[i].m_position.x);
+    minimum = _mm_min_ps(minimum, position);
+    maximum = _mm_max_ps(maximum, position);
+  }
+
+  _mm_store_ps(lo, minimum);
+  _mm_store_ps(hi, maximum);
+#elif defined(__ARM_NEON)
+  float32x4_t minimum = vld1q_f32(&vertices[0].m_position.x);
+  float32x4_t maximum = minimum;
+
+  for (unsigned int i = 1; i < count; ++i) {
+    float32x4_t position = vld1q_f32(&vertices[i].m_position.x);
+    minimum = vminq_f32(minimum, position);
+    maximum = vmaxq_f32(maximum, position);
+  }
+
+  vst1q_f32(lo, minimum);
+  vst1q_f32(hi, maximum);
+#else
+  for (unsigned int axis = 0; axis < 3; ++axis)
+    lo[axis] = hi[axis] = vertices[0].m_position[axis];
+
+  for (unsigned int i = 1; i < count; ++i) {
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+      lo[axis] = std::min(lo[axis], vertices[i].m_position[axis]);
+      hi[axis] = std::max(hi[axis], vertices[i].m_position[axis]);
+    }
+  }
+#endif
+
+  Bounds bounds;
+  bounds.min = vec3(lo[0], lo[1], lo[2]);
+  bounds.max = vec3(hi[0], hi[1], hi[2]);
+  bounds.center = (bounds.min + bounds.max) * 0.5f;
+
+  float radius = 0.0f;
+  for (unsigned int i = 0; i < count; ++i) {
+    vec3 delta = vertices[i].m_position - bounds.center;
+    radius = std::max(radius, delta * delta);
+  }
+  bounds.radius = std::sqrt(radius);
+
+  return bounds;
+}
+
+Bounds Bounds::transformed(const mat4& transform) const {
+  Bounds bounds;
+  bounds.center = (transform * vec4(center, 1.0f)).xyz();
+
+  float scale = 0.0f;
+  for (unsigned int col = 0; col < 3; ++col) {
+    vec3 axis(transform[0][col], transform[1][col], transform[2][col]);
+    scale = std::max(scale, axis * axis);
+  }
+  bounds.radius = radius * std::sqrt(scale);
+
+  for (unsigned int row = 0; row < 3; ++row) {
+    bounds.min[row] = bounds.max[row] = transform[row][3];
+
+    for (unsigned int col = 0; col < 3; ++col) {
+      float a = transform[row][col] * min[col];
+      float b = transform[row][col] * max[col];
+
+      bounds.min[row] += std::min(a, b);
+      bounds.max[row] += std::max(a, b);
+    }
+  }
+
+  return bounds;
+}
+
+Bounds BoundsArray::operator[](unsigned int index) const {
+  Bounds bounds;
+  bounds.center = vec3(component(CenterX)[index], component(CenterY)[index], component(CenterZ)[index]);
+  bounds.radius = component(Radius)[index];
+  bounds.min = vec3(component(MinX)[index], component(MinY)[index], component(MinZ)[index]);
+  bounds.max = vec3(component(MaxX)[index], component(MaxY)[index], component(MaxZ)[index]);
+
+  return bounds;
+}
+
+unsigned int BoundsArray::size() const {
+  return m_count;
+}
+
+unsigned int BoundsArray::bytes() const {
+  return m_data.size() * sizeof(float);
+}
+
+const float * BoundsArray::data() const {
+  return m_data.data();
+}
+
+const float * BoundsArray::component(BoundsComponent c) const {
+  return m_data.data() + c * m_count;
+}
+
+void BoundsArray::resize(unsigned int count) {
+  m_count = count;
+  m_data.assign(count * BoundsComponents, 0.0f);
+}
+
+void BoundsArray::set(unsigned int index, const Bounds& bounds) {
+  float values[BoundsComponents] = {
+    bounds.center.x, bounds.center.y, bounds.center.z, bounds.radius,
+    bounds.min.x, bounds.min.y, bounds.min.z,
+    bounds.max.x, bounds.max.y, bounds.max.z
+  };
+
+  for (unsigned int c = 0; c < BoundsComponents; ++c)
+    m_data[c * m_count + index] = values[c];
+}
+
+} // namespace ge
@@ -0,0 +1,755 @@
+#include "src/include/compute.hpp"
+#include "src/include/allocator.hpp"
+#include "src/include/engine.hpp"
+
+#include <cstring>
+
+namespace ge {
+
+static const unsigned int cullCode[] = {
+#include "cull.comp.inc"
+};
+
+static const unsigned int clusterCode[] = {
+#include "cluster.comp.inc"
+};
+
+static const unsigned int occlusionCode[] = {
+#include "occlusion.comp.inc"
+};
+
+static const unsigned int pyramidCode[] = {
+#include "pyramid.comp.inc"
+};
+
+const vk::raii::Buffer& ComputeManager::drawBuffer(unsigned int frameIndex) const {
+  return m_drawBuffers[frameIndex];
+}
+
+const vk::raii::Buffer& ComputeManager::countBuffer(unsigned int frameIndex) const {
+  return m_countBuffers[frameIndex];
+}
+
+unsigned int ComputeManager::drawOffset(unsigned int phase) const {
+  return phase * m_objectCount * m_commandSize;
+}
+
+unsigned int ComputeManager::countOffset(unsigned int phase) const {
+  return phase * m_batchCount * sizeof(unsigned int);
+}
+
+CullingStatistics ComputeManager::statistics(unsigned int frameIndex) const {
+  CullingStatistics statistics{ .commands = m_objectCount };
+  if (m_readbackMap == nullptr)
+    return statistics;
+
+  const unsigned int * counts = reinterpret_cast<const unsigned int *>(
+    reinterpret_cast<const char *>(m_readbackMap) + m_readbackOffsets[frameIndex]
+  );
+
+  unsigned int phases = m_occlusion ? 2 : 1;
+  for (unsigned int phase = 0; phase < phases; ++phase) {
+    for (unsigned int batch = 0; batch < m_batchCount; ++batch)
+      statistics.visible[phase] += counts[phase * m_batchCount + batch];
+  }
+
+  return statistics;
+}
+
+void ComputeManager::load(const Engine& engine) {
+  if (
+    engine.m_settings.culling_mode != GPUCulling &&
+    engine.m_settings.culling_mode != OcclusionCulling &&
+    engine.m_settings.culling_mode != ClusterCulling
+  ) return;
+
+  m_occlusion = engine.m_settings.culling_mode == OcclusionCulling;
+  m_clusters = engine.m_settings.culling_mode == ClusterCulling;
+  m_objectCount = m_clusters ? engine.m_objects.clusterData().size() : engine.m_objects.cullData().size();
+  m_batchCount = engine.m_objects.batchCount();
+  m_commandSize = engine.m_objects.commandSize();
+  if (m_objectCount == 0)
+    return;
+
+  createLayout(engine);
+  createPipeline(engine);
+  createBuffers(engine);
+
+  auto [tmp_setPool, tmp_sets] = Allocator::descriptorPool(engine, m_setLayout, engine.m_settings.buffer_mode, 5);
+  m_setPool = std::move(tmp_setPool);
+  m_sets = std::move(tmp_sets);
+
+  if (m_occlusion) {
+    createPyramid(engine);
+
+    auto [tmp_occlusionPool, tmp_occlusionSets] = Allocator::descriptorPool(engine, m_occlusionSetLayout,
+      engine.m_settings.buffer_mode, {
+        vk::DescriptorPoolSize{
+          .type             = vk::DescriptorType::eStorageBuffer,
+          .descriptorCount  = engine.m_settings.buffer_mode * 2
+        },
+        vk::DescriptorPoolSize{
+          .type             = vk::DescriptorType::eCombinedImageSampler,
+          .descriptorCount  = engine.m_settings.buffer_mode
+        }
+      }
+    );
+    m_occlusionSetPool = std::move(tmp_occlusionPool);
+    m_occlusionSets = std::move(tmp_occlusionSets);
+
+    auto [tmp_pyramidPool, tmp_pyramidSets] = Allocator::descriptorPool(engine, m_pyramidSetLayout,
+      m_pyramidLevels, {
+        vk::DescriptorPoolSize{
+          .type             = vk::DescriptorType::eCombinedImageSampler,
+          .descriptorCount  = m_pyramidLevels
+        },
+        vk::DescriptorPoolSize{
+          .type             = vk::DescriptorType::eStorageImage,
+          .descriptorCount  = m_pyramidLevels
+        }
+      }
+    );
+    m_pyramidSetPool = std::move(tmp_pyramidPool);
+    m_pyramidSets = std::move(tmp_pyramidSets);
+  }
+
+  updateSets(engine);
+}
+
+void ComputeManager::updateCullData(unsigned int frameIndex, const ObjectManager& objects) {
+  if (m_objectCount == 0 || m_cullVersions[frameIndex] == objects.cullVersion())
+    return;
+
+  if (m_clusters) {
+    memcpy(
+      reinterpret_cast<char *>(m_cullMap) + m_cullOffsets[frameIndex],
+      objects.clusterData().data(),
+      sizeof(ClusterData) * m_objectCount
+    );
+  }
+  else {
+    memcpy(
+      reinterpret_cast<char *>(m_cullMap) + m_cullOffsets[frameIndex],
+      objects.cullData().data(),
+      sizeof(CullData) * m_objectCount
+    );
+  }
+  m_cullVersions[frameIndex] = objects.cullVersion();
+}
+
+void ComputeManager::cull(
+  const vk::raii::CommandBuffer& cmd,
+  unsigned int frameIndex,
+  const mat4& viewProjection,
+  const vec3& camera,
+  unsigned int phase
+) {
+  if (m_objectCount == 0)
+    return;
+
+  if (phase == 0) {
+    cmd.fillBuffer(m_countBuffers[frameIndex], 0, vk::WholeSize, 0);
+
+    vk::BufferMemoryBarrier clearBarrier{
+      .srcAccessMask        = vk::AccessFlagBits::eTransferWrite,
+      .dstAccessMask        = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite,
+      .srcQueueFamilyIndex  = vk::QueueFamilyIgnored,
+      .dstQueueFamilyIndex  = vk::QueueFamilyIgnored,
+      .buffer               = m_countBuffers[frameIndex],
+      .size                 = vk::WholeSize
+    };
+
+    cmd.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::DependencyFlags(),
+      nullptr,
+      clearBarrier,
+      nullptr
+    );
+  }
+
+  if (m_occlusion) {
+    if (phase == 0) {
+      CullView view{
+        .planes                 = Frustum(viewProjection).planes(),
+        .viewProjection         = viewProjection,
+        .previousViewProjection = m_previousViewProjection
+      };
+
+      memcpy(reinterpret_cast<char *>(m_viewMap) + m_viewOffsets[frameIndex], &view, sizeof(CullView));
+      m_previousViewProjection = viewProjection;
+    }
+
+    OcclusionConstants constants{
+      .objectCount  = m_objectCount,
+      .batchCount   = m_batchCount,
+      .phase        = phase,
+      .occlusion    = m_pyramidReady
+    };
+
+    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, m_occlusionPipeline);
+    cmd.bindDescriptorSets(
+      vk::PipelineBindPoint::eCompute,
+      m_occlusionLayout,
+      0,
+      { *m_sets[frameIndex], *m_occlusionSets[frameIndex] },
+      nullptr
+    );
+    cmd.pushConstants(
+      m_occlusionLayout,
+      vk::ShaderStageFlagBits::eCompute,
+      0,
+      vk::ArrayProxy<const char>(sizeof(OcclusionConstants), reinterpret_cast<const char *>(&constants))
+    );
+  }
+  else if (m_clusters) {
+    ClusterConstants constants{
+      .planes       = Frustum(viewProjection).planes(),
+      .camera       = vec4(camera, 1.0f),
+      .clusterCount = m_objectCount
+    };
+
+    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, m_cullPipeline);
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_layout, 0, *m_sets[frameIndex], nullptr);
+    cmd.pushConstants(
+      m_layout,
+      vk::ShaderStageFlagBits::eCompute,
+      0,
+      vk::ArrayProxy<const char>(sizeof(ClusterConstants), reinterpret_cast<const char *>(&constants))
+    );
+  }
+  else {
+    CullConstants constants{
+      .planes       = Frustum(viewProjection).planes(),
+      .objectCount  = m_objectCount
+    };
+
+    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, m_cullPipeline);
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_layout, 0, *m_sets[frameIndex], nullptr);
+    cmd.pushConstants(
+      m_layout,
+      vk::ShaderStageFlagBits::eCompute,
+      0,
+      vk::ArrayProxy<const char>(sizeof(CullConstants), reinterpret_cast<const char *>(&constants))
+    );
+  }
+
+  cmd.dispatch((m_objectCount + 63) / 64, 1, 1);
+
+  vk::MemoryBarrier drawBarrier{
+    .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+    .dstAccessMask = vk::AccessFlagBits::eIndirectCommandRead
+  };
+
+  cmd.pipelineBarrier(
+    vk::PipelineStageFlagBits::eComputeShader,
+    vk::PipelineStageFlagBits::eDrawIndirect,
+    vk::DependencyFlags(),
+    drawBarrier,
+    nullptr,
+    nullptr
+  );
+}
+
+void ComputeManager::readCounts(const vk::raii::CommandBuffer& cmd, unsigned int frameIndex) const {
+  if (m_objectCount == 0)
+    return;
+
+  vk::BufferMemoryBarrier countBarrier{
+    .srcAccessMask        = vk::AccessFlagBits::eShaderWrite,
+    .dstAccessMask        = vk::AccessFlagBits::eTransferRead,
+    .srcQueueFamilyIndex  = vk::QueueFamilyIgnored,
+    .dstQueueFamilyIndex  = vk::QueueFamilyIgnored,
+    .buffer               = m_countBuffers[frameIndex],
+    .size                 = vk::WholeSize
+  };
+
+  cmd.pipelineBarrier(
+    vk::PipelineStageFlagBits::eComputeShader,
+    vk::PipelineStageFlagBits::eTransfer,
+    vk::DependencyFlags(),
+    nullptr,
+    countBarrier,
+    nullptr
+  );
+
+  unsigned int phases = m_occlusion ? 2 : 1;
+  cmd.copyBuffer(m_countBuffers[frameIndex], m_readbackBuffers[frameIndex], vk::BufferCopy{
+    .size = phases * m_batchCount * sizeof(unsigned int)
+  });
+
+  vk::BufferMemoryBarrier readbackBarrier{
+    .srcAccessMask        = vk::AccessFlagBits::eTransferWrite,
+    .dstAccessMask        = vk::AccessFlagBits::eHostRead,
+    .srcQueueFamilyIndex  = vk::QueueFamilyIgnored,
+    .dstQueueFamilyIndex  = vk::QueueFamilyIgnored,
+    .buffer               = m_readbackBuffers[frameIndex],
+    .size                 = vk::WholeSize
+  };
+
+  cmd.pipelineBarrier(
+    vk::PipelineStageFlagBits::eTransfer,
+    vk::PipelineStageFlagBits::eHost,
+    vk::DependencyFlags(),
+    nullptr,
+    readbackBarrier,
+    nullptr
+  );
+}
+
+void ComputeManager::buildPyramid(const vk::raii::CommandBuffer& cmd, const vk::raii::Image& depthImage) {
+  if (!m_occlusion || m_objectCount == 0)
+    return;
+
+  vk::ImageMemoryBarrier barriers[2] = {
+    vk::ImageMemoryBarrier{
+      .srcAccessMask    = vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+      .dstAccessMask    = vk::AccessFlagBits::eShaderRead,
+      .oldLayout        = vk::ImageLayout::eDepthStencilAttachmentOptimal,
+      .newLayout        = vk::ImageLayout::eShaderReadOnlyOptimal,
+      .image            = depthImage,
+      .subresourceRange = {
+        .aspectMask = vk::ImageAspectFlagBits::eDepth,
+        .levelCount = 1,
+        .layerCount = 1
+      }
+    },
+    vk::ImageMemoryBarrier{
+      .srcAccessMask    = vk::AccessFlagBits::eShaderRead,
+      .dstAccessMask    = vk::AccessFlagBits::eShaderWrite,
+      .oldLayout        = m_pyramidReady ? vk::ImageLayout::eGeneral : vk::ImageLayout::eUndefined,
+      .newLayout        = vk::ImageLayout::eGeneral,
+      .image            = m_pyramid,
+      .subresourceRange = {
+        .aspectMask = vk::ImageAspectFlagBits::eColor,
+        .levelCount = m_pyramidLevels,
+        .layerCount = 1
+      }
+    }
+  };
+
+  cmd.pipelineBarrier(
+    vk::PipelineStageFlagBits::eLateFragmentTests | vk::PipelineStageFlagBits::eComputeShader,
+    vk::PipelineStageFlagBits::eComputeShader,
+    vk::DependencyFlags(),
+    nullptr,
+    nullptr,
+    barriers
+  );
+
+  cmd.bindPipeline(vk::PipelineBindPoint::eCompute, m_pyramidPipeline);
+
+  vk::MemoryBarrier levelBarrier{
+    .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+    .dstAccessMask = vk::AccessFlagBits::eShaderRead
+  };
+
+  for (unsigned int level = 0; level < m_pyramidLevels; ++level) {
+    unsigned int width = std::max(m_pyramidExtent.width >> level, 1u);
+    unsigned int height = std::max(m_pyramidExtent.height >> level, 1u);
+
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_pyramidLayout, 0, *m_pyramidSets[level], nullptr);
+    cmd.dispatch((width + 7) / 8, (height + 7) / 8, 1);
+
+    cmd.pipelineBarrier(
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::DependencyFlags(),
+      levelBarrier,
+      nullptr,
+      nullptr
+    );
+  }
+
+  barriers[0].srcAccessMask = vk::AccessFlagBits::eShaderRead;
+  barriers[0].dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite;
+  barriers[0].oldLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+  barriers[0].newLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+
+  cmd.pipelineBarrier(
+    vk::PipelineStageFlagBits::eComputeShader,
+    vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests,
+    vk::DependencyFlags(),
+    nullptr,
+    nullptr,
+    barriers[0]
+  );
+
+  m_pyramidReady = true;
+}
+
+void ComputeManager::createLayout(const Engine& engine) {
+  std::vector<vk::DescriptorSetLayoutBinding> bindings;
+  for (unsigned int i = 0; i < 5; ++i) {
+    bindings.emplace_back(vk::DescriptorSetLayoutBinding{
+      .binding          = i,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eCompute
+    });
+  }
+
+  m_setLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .bindingCount = static_cast<unsigned int>(bindings.size()),
+    .pBindings    = bindings.data()
+  });
+
+  vk::PushConstantRange range{
+    .stageFlags = vk::ShaderStageFlagBits::eCompute,
+    .size       = m_clusters ? sizeof(ClusterConstants) : sizeof(CullConstants)
+  };
+
+  m_layout = engine.m_context.device().createPipelineLayout(vk::PipelineLayoutCreateInfo{
+    .setLayoutCount         = 1,
+    .pSetLayouts            = &*m_setLayout,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &range
+  });
+
+  if (!m_occlusion)
+    return;
+
+  vk::DescriptorSetLayoutBinding occlusionBindings[3] = {
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 0,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eCompute
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 1,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eCompute
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 2,
+      .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eCompute
+    }
+  };
+
+  m_occlusionSetLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .bindingCount = 3,
+    .pBindings    = occlusionBindings
+  });
+
+  vk::DescriptorSetLayout occlusionSetLayouts[2] = { *m_setLayout, *m_occlusionSetLayout };
+
+  vk::PushConstantRange occlusionRange{
+    .stageFlags = vk::ShaderStageFlagBits::eCompute,
+    .size       = sizeof(OcclusionConstants)
+  };
+
+  m_occlusionLayout = engine.m_context.device().createPipelineLayout(vk::PipelineLayoutCreateInfo{
+    .setLayoutCount         = 2,
+    .pSetLayouts            = occlusionSetLayouts,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &occlusionRange
+  });
+
+  vk::DescriptorSetLayoutBinding pyramidBindings[2] = {
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 0,
+      .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eCompute
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 1,
+      .descriptorType   = vk::DescriptorType::eStorageImage,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eCompute
+    }
+  };
+
+  m_pyramidSetLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .bindingCount = 2,
+    .pBindings    = pyramidBindings
+  });
+
+  m_pyramidLayout = engine.m_context.device().createPipelineLayout(vk::PipelineLayoutCreateInfo{
+    .setLayoutCount = 1,
+    .pSetLayouts    = &*m_pyramidSetLayout
+  });
+}
+
+void ComputeManager::createPipeline(const Engine& engine) {
+  auto create = [&engine](const vk::raii::PipelineLayout& layout, const unsigned int * code, unsigned int size) {
+    vk::raii::ShaderModule module = engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
+      .codeSize = size,
+      .pCode    = code
+    });
+
+    return engine.m_pipelineCache.createComputePipeline(engine, vk::ComputePipelineCreateInfo{
+      .stage = vk::PipelineShaderStageCreateInfo{
+        .stage  = vk::ShaderStageFlagBits::eCompute,
+        .module = module,
+        .pName  = "main"
+      },
+      .layout = layout
+    });
+  };
+
+  if (m_clusters)
+    m_cullPipeline = create(m_layout, clusterCode, sizeof(clusterCode));
+  else
+    m_cullPipeline = create(m_layout, cullCode, sizeof(cullCode));
+
+  if (m_occlusion) {
+    m_occlusionPipeline = create(m_occlusionLayout, occlusionCode, sizeof(occlusionCode));
+    m_pyramidPipeline = create(m_pyramidLayout, pyramidCode, sizeof(pyramidCode));
+  }
+}
+
+void ComputeManager::createBuffers(const Engine& engine) {
+  unsigned int phases = m_occlusion ? 2 : 1;
+
+  std::vector<vk::BufferCreateInfo> cullInfos;
+  std::vector<vk::BufferCreateInfo> drawInfos;
+  std::vector<vk::BufferCreateInfo> countInfos;
+  std::vector<vk::BufferCreateInfo> readbackInfos;
+  std::vector<vk::BufferCreateInfo> visibilityInfos;
+  std::vector<vk::BufferCreateInfo> viewInfos;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    cullInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = static_cast<unsigned int>((m_clusters ? sizeof(ClusterData) : sizeof(CullData)) * m_objectCount),
+      .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+
+    drawInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = phases * m_commandSize * m_objectCount,
+      .usage        = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+
+    countInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = static_cast<unsigned int>(phases * sizeof(unsigned int) * m_batchCount),
+      .usage        = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
+                      vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+
+    readbackInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = static_cast<unsigned int>(phases * sizeof(unsigned int) * m_batchCount),
+      .usage        = vk::BufferUsageFlagBits::eTransferDst,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+
+    visibilityInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = static_cast<unsigned int>(sizeof(unsigned int) * m_objectCount),
+      .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+
+    viewInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = sizeof(CullView),
+      .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+  }
+
+  auto [tmp_cullMem, tmp_cullBufs, tmp_cullOffs, cullSize] = Allocator::bufferPool(engine, cullInfos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_cullMemory = std::move(tmp_cullMem);
+  m_cullBuffers = std::move(tmp_cullBufs);
+  m_cullOffsets = std::move(tmp_cullOffs);
+
+  auto [tmp_drawMem, tmp_drawBufs, tmp_drawOffs, drawSize] = Allocator::bufferPool(engine, drawInfos,
+    vk::MemoryPropertyFlagBits::eDeviceLocal
+  );
+  m_drawMemory = std::move(tmp_drawMem);
+  m_drawBuffers = std::move(tmp_drawBufs);
+
+  auto [tmp_countMem, tmp_countBufs, tmp_countOffs, countSize] = Allocator::bufferPool(engine, countInfos,
+    vk::MemoryPropertyFlagBits::eDeviceLocal
+  );
+  m_countMemory = std::move(tmp_countMem);
+  m_countBuffers = std::move(tmp_countBufs);
+
+  auto [tmp_readbackMem, tmp_readbackBufs, tmp_readbackOffs, readbackSize] = Allocator::bufferPool(engine, readbackInfos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_readbackMemory = std::move(tmp_readbackMem);
+  m_readbackBuffers = std::move(tmp_readbackBufs);
+  m_readbackOffsets = std::move(tmp_readbackOffs);
+  m_readbackMap = m_readbackMemory.mapMemory(0, readbackSize);
+
+  m_cullMap = m_cullMemory.mapMemory(0, cullSize);
+  m_cullVersions.assign(engine.m_settings.buffer_mode, ~engine.m_objects.cullVersion());
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i)
+    updateCullData(i, engine.m_objects);
+
+  if (!m_occlusion)
+    return;
+
+  auto [tmp_visMem, tmp_visBufs, tmp_visOffs, visSize] = Allocator::bufferPool(engine, visibilityInfos,
+    vk::MemoryPropertyFlagBits::eDeviceLocal
+  );
+  m_visibilityMemory = std::move(tmp_visMem);
+  m_visibilityBuffers = std::move(tmp_visBufs);
+
+  auto [tmp_viewMem, tmp_viewBufs, tmp_viewOffs, viewSize] = Allocator::bufferPool(engine, viewInfos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_viewMemory = std::move(tmp_viewMem);
+  m_viewBuffers = std::move(tmp_viewBufs);
+  m_viewOffsets = std::move(tmp_viewOffs);
+
+  m_viewMap = m_viewMemory.mapMemory(0, viewSize);
+}
+
+void ComputeManager::createPyramid(const Engine& engine) {
+  m_pyramidExtent = vk::Extent2D{
+    .width  = std::max((engine.m_settings.extent.width + 1) / 2, 1u),
+    .height = std::max((engine.m_settings.extent.height + 1) / 2, 1u)
+  };
+
+  m_pyramidLevels = 0;
+  for (unsigned int size = std::max(m_pyramidExtent.width, m_pyramidExtent.height); size > 0; size >>= 1)
+    ++m_pyramidLevels;
+
+  auto [tmp_pMem, tmp_pImg, tmp_pView] = Allocator::imageResources(engine, vk::ImageCreateInfo{
+    .imageType  = vk::ImageType::e2D,
+    .format     = vk::Format::eR32Sfloat,
+    .extent     = {
+      .width  = m_pyramidExtent.width,
+      .height = m_pyramidExtent.height,
+      .depth  = 1
+    },
+    .mipLevels    = m_pyramidLevels,
+    .arrayLayers  = 1,
+    .samples      = vk::SampleCountFlagBits::e1,
+    .tiling       = vk::ImageTiling::eOptimal,
+    .usage        = vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled,
+    .sharingMode  = vk::SharingMode::eExclusive
+  }, vk::ImageAspectFlagBits::eColor);
+  m_pyramidMemory = std::move(tmp_pMem);
+  m_pyramid = std::move(tmp_pImg);
+  m_pyramidView = std::move(tmp_pView);
+
+  for (unsigned int level = 0; level < m_pyramidLevels; ++level) {
+    m_pyramidLevelViews.emplace_back(engine.m_context.device().createImageView(vk::ImageViewCreateInfo{
+      .image            = m_pyramid,
+      .viewType         = vk::ImageViewType::e2D,
+      .format           = vk::Format::eR32Sfloat,
+      .subresourceRange = {
+        .aspectMask   = vk::ImageAspectFlagBits::eColor,
+        .baseMipLevel = level,
+        .levelCount   = 1,
+        .layerCount   = 1
+      }
+    }));
+  }
+
+  m_pyramidSampler = engine.m_context.device().createSampler(vk::SamplerCreateInfo{
+    .magFilter    = vk::Filter::eNearest,
+    .minFilter    = vk::Filter::eNearest,
+    .mipmapMode   = vk::SamplerMipmapMode::eNearest,
+    .addressModeU = vk::SamplerAddressMode::eClampToEdge,
+    .addressModeV = vk::SamplerAddressMode::eClampToEdge,
+    .addressModeW = vk::SamplerAddressMode::eClampToEdge,
+    .maxLod       = vk::LodClampNone
+  });
+}
+
+void ComputeManager::updateSets(const Engine& engine) {
+  std::vector<vk::DescriptorBufferInfo> infos;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = engine.m_materials.transformBuffer(i), .range = vk::WholeSize });
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_cullBuffers[i], .range = vk::WholeSize });
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = engine.m_objects.indirectBuffer(i), .range = vk::WholeSize });
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_drawBuffers[i], .range = vk::WholeSize });
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_countBuffers[i], .range = vk::WholeSize });
+  }
+
+  std::vector<vk::WriteDescriptorSet> writes;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    for (unsigned int binding = 0; binding < 5; ++binding) {
+      writes.emplace_back(vk::WriteDescriptorSet{
+        .dstSet           = m_sets[i],
+        .dstBinding       = binding,
+        .descriptorCount  = 1,
+        .descriptorType   = vk::DescriptorType::eStorageBuffer,
+        .pBufferInfo      = &infos[i * 5 + binding]
+      });
+    }
+  }
+
+  if (!m_occlusion) {
+    engine.m_context.device().updateDescriptorSets(writes, nullptr);
+    return;
+  }
+
+  std::vector<vk::DescriptorBufferInfo> occlusionInfos;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    occlusionInfos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_visibilityBuffers[i], .range = vk::WholeSize });
+    occlusionInfos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_viewBuffers[i], .range = vk::WholeSize });
+  }
+
+  vk::DescriptorImageInfo pyramidInfo{
+    .sampler      = m_pyramidSampler,
+    .imageView    = m_pyramidView,
+    .imageLayout  = vk::ImageLayout::eGeneral
+  };
+
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    for (unsigned int binding = 0; binding < 2; ++binding) {
+      writes.emplace_back(vk::WriteDescriptorSet{
+        .dstSet           = m_occlusionSets[i],
+        .dstBinding       = binding,
+        .descriptorCount  = 1,
+        .descriptorType   = vk::DescriptorType::eStorageBuffer,
+        .pBufferInfo      = &occlusionInfos[i * 2 + binding]
+      });
+    }
+
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = m_occlusionSets[i],
+      .dstBinding       = 2,
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+      .pImageInfo       = &pyramidInfo
+    });
+  }
+
+  std::vector<vk::DescriptorImageInfo> levelInfos;
+  for (unsigned int level = 0; level < m_pyramidLevels; ++level) {
+    levelInfos.emplace_back(vk::DescriptorImageInfo{
+      .sampler      = m_pyramidSampler,
+      .imageView    = level == 0 ? *engine.m_renderer.depthView() : *m_pyramidLevelViews[level - 1],
+      .imageLayout  = level == 0 ? vk::ImageLayout::eShaderReadOnlyOptimal : vk::ImageLayout::eGeneral
+    });
+
+    levelInfos.emplace_back(vk::DescriptorImageInfo{
+      .imageView    = m_pyramidLevelViews[level],
+      .imageLayout  = vk::ImageLayout::eGeneral
+    });
+  }
+
+  for (unsigned int level = 0; level < m_pyramidLevels; ++level) {
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = m_pyramidSets[level],
+      .dstBinding       = 0,
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+      .pImageInfo       = &levelInfos[level * 2]
+    });
+
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = m_pyramidSets[level],
+      .dstBinding       = 1,
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eStorageImage,
+      .pImageInfo       = &levelInfos[level * 2 + 1]
+    });
+  }
+
+  engine.m_context.device().updateDescriptorSets(writes, nullptr);
+}
+
+} // namespace ge
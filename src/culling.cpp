@@ -0,0 +1,114 @@
+#include "src/include/culling.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+#elif defined(__ARM_NEON)
+  #include <arm_neon.h>
+#endif
+
+#include <cmath>
+
+namespace ge {
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("avx")))
+static unsigned int cullAVX(
+  const std::array<vec4, 6>& planes,
+  const BoundsArray& bounds,
+  unsigned int first,
+  unsigned int last,
+  unsigned char * visible
+) {
+  const float * cx = bounds.component(CenterX);
+  const float * cy = bounds.component(CenterY);
+  const float * cz = bounds.component(CenterZ);
+  const float * r = bounds.component(Radius);
+
+  unsigned int i = first;
+  for (; i + 8 <= last; i += 8) {
+    __m256 x = _mm256_loadu_ps(cx + i);
+    __m256 y = _mm256_loadu_ps(cy + i);
+    __m256 z = _mm256_loadu_ps(cz + i);
+    __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(r + i));
+
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (const auto& plane : planes) {
+      __m256 distance = _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(plane.x)), _mm256_mul_ps(y, _mm256_set1_ps(plane.y))),
+        _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(plane.z)), _mm256_set1_ps(plane.w))
+      );
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+    }
+
+    unsigned int mask = _mm256_movemask_ps(inside);
+    for (unsigned int lane = 0; lane < 8; ++lane)
+      visible[i + lane] = (mask >> lane) & 1;
+  }
+
+  return i;
+}
+
+#endif
+
+Frustum::Frustum(const mat4& viewProjection) {
+  const vec4& x = viewProjection[0];
+  const vec4& y = viewProjection[1];
+  const vec4& z = viewProjection[2];
+  const vec4& w = viewProjection[3];
+
+  m_planes = { w + x, w - x, w + y, w - y, z, w - z };
+
+  for (auto& plane : m_planes)
+    plane /= plane.xyz().magnitude();
+}
+
+const std::array<vec4, 6>& Frustum::planes() const {
+  return m_planes;
+}
+
+bool Frustum::intersects(const Bounds& bounds) const {
+  for (const auto& plane : m_planes) {
+    if (plane.xyz() * bounds.center + plane.w < -bounds.radius)
+      return false;
+  }
+
+  return true;
+}
+
+void Frustum::cull(const BoundsArray& bounds, unsigned int first, unsigned int last, unsigned char * visible) const {
+  unsigned int i = first;
+
+#if defined(__x86_64__) || defined(__i386__)
+  static const bool avx = __builtin_cpu_supports("avx");
+  if (avx) i = cullAVX(m_planes, bounds, first, last, visible);
+#elif defined(__ARM_NEON)
+  const float * cx = bounds.component(CenterX);
+  const float * cy = bounds.component(CenterY);
+  const float * cz = bounds.component(CenterZ);
+  const float * r = bounds.component(Radius);
+
+  for (; i + 4 <= last; i += 4) {
+    float32x4_t x = vld1q_f32(cx + i);
+    float32x4_t y = vld1q_f32(cy + i);
+    float32x4_t z = vld1q_f32(cz + i);
+    float32x4_t negRadius = vnegq_f32(vld1q_f32(r + i));
+
+    uint32x4_t inside = vdupq_n_u32(~0u);
+    for (const auto& plane : m_planes) {
+      float32x4_t distance = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(plane.w), x, plane.x), y, plane.y), z, plane.z);
+      inside = vandq_u32(inside, vcgeq_f32(distance, negRadius));
+    }
+
+    visible[i] = vgetq_lane_u32(inside, 0) & 1;
+    visible[i + 1] = vgetq_lane_u32(inside, 1) & 1;
+    visible[i + 2] = vgetq_lane_u32(inside, 2) & 1;
+    visible[i + 3] = vgetq_lane_u32(inside, 3) & 1;
+  }
+#endif
+
+  for (; i < last; ++i)
+    visible[i] = intersects(bounds[i]);
+}
+
+} // namespace ge
@@ -1,6 +1,7 @@
 #include "src/include/engine.hpp"
 
 #include <chrono>
+#include <cmath>
 #include <future>
 
 namespace ge {
@@ -18,6 +19,14 @@ Engine::Engine(Settings&& settings) : m_settings(settings) {
 }
 
 Engine::~Engine() {
+  if (m_loaded) {
+    m_materials.finishPipelines();
+    m_context.device().waitIdle();
+    m_pipelineCache.save(*this);
+  }
+
+  if (m_settings.headless) return;
+
   glfwDestroyWindow(m_window);
   glfwTerminate();
 }
@@ -34,22 +43,93 @@ void Engine::add_material(std::string tag, MaterialManager::Builder&& builder) {
   m_materials.add(tag, std::move(builder));
 }
 
+void Engine::add_texture(std::string tag, unsigned int width, unsigned int height, const std::vector<unsigned char>& pixels) {
+  if (m_textures.exists(tag))
+    throw std::runtime_error("groot-engine: texture '" + tag + "' already exists");
+
+  unsigned int index = m_textures.add(*this, tag, width, height, pixels);
+  if (m_textures.loaded())
+    m_materials.updateTextures(*this, index);
+}
+
 transform Engine::add_object(std::string material, std::string path, const Transform& transform) {
   if (!m_materials.exists(material))
     throw std::runtime_error("groot-engine: material '" + material + "' does not exist");
   return m_objects.add(material, path, transform);
 }
 
+transform Engine::add_dynamic_object(std::string material, std::string path, const Transform& transform) {
+  if (!m_materials.exists(material))
+    throw std::runtime_error("groot-engine: material '" + material + "' does not exist");
+  return m_objects.addDynamic(material, path, transform);
+}
+
+void Engine::set_parameter(std::string material, std::string name, const ParameterValue& value) {
+  if (!m_materials.exists(material))
+    throw std::runtime_error("groot-engine: material '" + material + "' does not exist");
+  m_materials.setParameter(material, name, value);
+}
+
+void Engine::set_parameter(const transform& object, std::string name, const ParameterValue& value) {
+  m_materials.setParameter(m_objects.material(object), object.get(), name, value);
+}
+
+void Engine::update_vertices(const transform& object, unsigned int first, const std::vector<Vertex>& vertices) {
+  m_objects.batchVertices(object, first, vertices);
+}
+
+void Engine::set_occluder(const transform& object, bool occluder) {
+  m_objects.setOccluder(object, occluder);
+}
+
+Bounds Engine::bounds(const transform& object) const {
+  return m_objects.bounds(object);
+}
+
+OptimizationReport Engine::optimization_report(const transform& object) const {
+  return m_objects.optimization(object);
+}
+
+PipelineCacheStatistics Engine::pipeline_cache_statistics() const {
+  return m_pipelineCache.statistics();
+}
+
+CullingStatistics Engine::culling_statistics() const {
+  if (!m_loaded)
+    return CullingStatistics();
+
+  m_context.device().waitIdle();
+  unsigned int frameIndex = (m_renderer.frameIndex() + m_settings.buffer_mode - 1) % m_settings.buffer_mode;
+  return m_compute.statistics(frameIndex);
+}
+
+void Engine::render_frame() {
+  if (!m_loaded)
+    load();
+
+  m_frameTime = m_settings.time_step;
+  m_renderer.render(*this);
+  batchUpdates();
+}
+
+void Engine::close() {
+  m_closing = true;
+}
+
 void Engine::run() {
   run([](){});
 }
 
 bool Engine::shouldClose() const {
-  return glfwWindowShouldClose(m_window);
+  if (m_settings.headless)
+    return m_closing;
+
+  return m_closing || glfwWindowShouldClose(m_window);
 }
 
 void Engine::pollEvents() const {
-  glfwPollEvents();
+  if (!m_settings.headless)
+    glfwPollEvents();
 }
 
 vk::raii::CommandBuffers Engine::getCmds(QueueFamilyType type, unsigned int count) const {
@@ -61,7 +141,9 @@ vk::raii::CommandBuffers Engine::getCmds(QueueFamilyType type, unsigned int coun
 }
 
 void Engine::initialize() {
-  createWindow();
+  if (!m_settings.headless)
+    createWindow();
+
   m_context.initialize(*this);
   createSurface();
   m_context.initialize(*this);
@@ -91,6 +173,12 @@ void Engine::createWindow() {
 }
 
 void Engine::createSurface() {
+  if (m_settings.headless) {
+    if (m_context.headlessSurface())
+      m_surface = m_context.instance().createHeadlessSurfaceEXT(vk::HeadlessSurfaceCreateInfoEXT{});
+    return;
+  }
+
   VkSurfaceKHR surface;
   if (glfwCreateWindowSurface(*m_context.instance(), m_window, nullptr, &surface) != VK_SUCCESS)
     throw std::runtime_error("groot-engine: failed to create window surface");
@@ -119,17 +207,32 @@ void Engine::createCommandPools() {
 
 void Engine::load() {
   m_objects.loadTransforms();
+  m_pipelineCache.load(*this);
+  m_textures.load(*this);
 
   std::future materialThread = std::async(std::launch::async,
-    [this](){ this->m_materials.load(*this, this->m_objects.transforms()); }
+    [this](){ this->m_materials.load(*this, this->m_objects.transforms(), this->m_objects.bounds(), this->m_objects.materials()); }
   );
 
   std::future objectThread = std::async(std::launch::async,
-    [this]() { this->m_objects.load(*this); }
+    [this]() { this->m_objects.load(*this, m_workers); }
   );
 
   materialThread.get();
   objectThread.get();
+
+  m_objects.loadVertexSets(*this, m_materials.vertexSetLayout());
+  m_compute.load(*this);
+
+  if (m_settings.impostor_distance > 0.0f)
+    m_materials.waitPipelines(*this);
+
+  m_impostors.load(*this);
+
+  if (m_settings.culling_mode == SoftwareOcclusionCulling)
+    m_occlusion.resize(m_settings.occlusion_extent.width, m_settings.occlusion_extent.height);
+
+  m_loaded = true;
 }
 
 void Engine::updateTimes() {
@@ -144,8 +247,39 @@ void Engine::updateTimes() {
 }
 
 void Engine::batchUpdates() {
+  m_renderer.waitForFrame(*this);
+  m_objects.restoreOrder(m_renderer.frameIndex());
+  m_materials.updatePipelines(*this);
+
   m_objects.updateTransforms();
+  m_objects.updateVertices(m_renderer.frameIndex());
+
+  if (m_settings.lod_levels > 1)
+    m_objects.selectLods(m_renderer.frameIndex(), m_renderer.viewProjection(), std::abs(m_renderer.projection()[1].y));
+
+  if (m_settings.culling_mode == CPUCulling) {
+    m_objects.cull(m_renderer.frameIndex(), Frustum(m_renderer.viewProjection()), m_workers);
+  }
+  else if (m_settings.culling_mode == SoftwareOcclusionCulling) {
+    m_occlusion.render(m_renderer.viewProjection(), m_objects.occluders(), m_workers);
+    m_objects.cull(m_renderer.frameIndex(), Frustum(m_renderer.viewProjection()), m_workers, &m_occlusion);
+  }
+  else if (
+    m_settings.culling_mode == GPUCulling ||
+    m_settings.culling_mode == OcclusionCulling ||
+    m_settings.culling_mode == ClusterCulling
+  ) {
+    m_compute.updateCullData(m_renderer.frameIndex(), m_objects);
+  }
+
+  if (m_settings.impostor_distance > 0.0f)
+    m_impostors.update(m_renderer.frameIndex(), m_objects, m_renderer.cameraPosition());
+
+  m_objects.sortBatches(m_renderer.frameIndex(), m_renderer.viewProjection(), m_materials.transparent());
+
   m_materials.updateTransforms(m_renderer.frameIndex(), m_objects.transforms());
+  m_materials.updateBounds(m_renderer.frameIndex(), m_objects.bounds());
+  m_materials.updateParameters(m_renderer.frameIndex());
   m_objects.updateTimes(m_frameTime);
 }
 
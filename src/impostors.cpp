@@ -0,0 +1,656 @@
+#include "src/include/impostors.hpp"
+#include "src/include/allocator.hpp"
+#include "src/include/engine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <optional>
+
+namespace ge {
+
+static const unsigned int impostorVertCode[] = {
+#include "impostor.vert.inc"
+};
+
+static const unsigned int impostorFragCode[] = {
+#include "impostor.frag.inc"
+};
+
+void ImpostorManager::load(const Engine& engine) {
+  m_distance = engine.m_settings.impostor_distance;
+  m_views = std::max(engine.m_settings.impostor_views, 1u);
+  m_resolution = std::max(engine.m_settings.impostor_resolution, 1u);
+  m_cpuCulling = engine.m_settings.culling_mode == CPUCulling ||
+                 engine.m_settings.culling_mode == SoftwareOcclusionCulling;
+  if (m_distance <= 0.0f)
+    return;
+
+  createAtlases(engine);
+  if (m_instanceCount == 0)
+    return;
+
+  createLayout(engine);
+  createPipeline(engine);
+  createBuffers(engine);
+
+  auto [tmp_instancePool, tmp_instanceSets] = Allocator::descriptorPool(engine, m_instanceSetLayout, engine.m_settings.buffer_mode);
+  m_instanceSetPool = std::move(tmp_instancePool);
+  m_instanceSets = std::move(tmp_instanceSets);
+
+  auto [tmp_atlasPool, tmp_atlasSets] = Allocator::descriptorPool(engine, m_atlasSetLayout,
+    m_atlases.size(), {
+      vk::DescriptorPoolSize{
+        .type             = vk::DescriptorType::eCombinedImageSampler,
+        .descriptorCount  = static_cast<unsigned int>(m_atlases.size())
+      }
+    }
+  );
+  m_atlasSetPool = std::move(tmp_atlasPool);
+  m_atlasSets = std::move(tmp_atlasSets);
+
+  updateSets(engine);
+  bakeAtlases(engine);
+}
+
+void ImpostorManager::update(unsigned int frameIndex, ObjectManager& objects, const vec3& eye) {
+  if (m_instanceCount == 0 || objects.m_indirectMap == nullptr)
+    return;
+
+  ObjectManager::IndirectCommand * commands = reinterpret_cast<ObjectManager::IndirectCommand *>(
+    reinterpret_cast<char *>(objects.m_indirectMap) + objects.m_indirectOffsets[frameIndex]
+  );
+  Instance * instances = reinterpret_cast<Instance *>(
+    reinterpret_cast<char *>(m_instanceMap) + m_instanceOffsets[frameIndex]
+  );
+
+  float distance = m_distance * m_distance;
+
+  const float * cx = objects.m_worldBounds.component(CenterX);
+  const float * cy = objects.m_worldBounds.component(CenterY);
+  const float * cz = objects.m_worldBounds.component(CenterZ);
+  const float * r = objects.m_worldBounds.component(Radius);
+
+  for (unsigned int a = 0; a < m_atlases.size(); ++a) {
+    const Atlas& atlas = m_atlases[a];
+    unsigned int count = 0;
+
+    for (unsigned int i = 0; i < atlas.objects.size(); ++i) {
+      unsigned int index = atlas.objects[i];
+      vec3 center(cx[index], cy[index], cz[index]);
+      vec3 offset = eye - center;
+
+      if (offset * offset < distance) {
+        if (!m_cpuCulling) commands[index].instanceCount = 1;
+        continue;
+      }
+
+      bool visible = !m_cpuCulling || commands[index].instanceCount != 0;
+      commands[index].instanceCount = 0;
+      if (!visible) continue;
+
+      const mat4& model = objects.m_transforms[index];
+      vec3 x(model[0].x, model[1].x, model[2].x);
+      vec3 z(model[0].z, model[1].z, model[2].z);
+
+      float angle = std::atan2((x * offset) / (x * x), (z * offset) / (z * z));
+      int views = static_cast<int>(m_views);
+      int step = static_cast<int>(std::lround(angle * views / (2.0f * std::numbers::pi_v<float>)));
+      unsigned int tile = static_cast<unsigned int>((step % views + views) % views);
+
+      instances[atlas.first + count++] = Instance{
+        .sphere = vec4(center, r[index]),
+        .tile   = i * m_views + tile
+      };
+    }
+
+    m_counts[frameIndex * m_atlases.size() + a] = count;
+  }
+}
+
+void ImpostorManager::draw(
+  const vk::raii::CommandBuffer& cmd,
+  unsigned int frameIndex,
+  const mat4& viewProjection,
+  const mat4& view
+) const {
+  if (m_instanceCount == 0)
+    return;
+
+  ImpostorConstants constants{
+    .viewProjection = viewProjection,
+    .right          = vec4(view[0].xyz(), 0.0f),
+    .up             = vec4(view[1].xyz(), 0.0f)
+  };
+
+  cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, m_pipeline);
+  cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_layout, 0, *m_instanceSets[frameIndex], nullptr);
+
+  for (unsigned int a = 0; a < m_atlases.size(); ++a) {
+    unsigned int count = m_counts[frameIndex * m_atlases.size() + a];
+    if (count == 0) continue;
+
+    constants.columns = m_atlases[a].columns;
+    constants.rows = m_atlases[a].rows;
+
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_layout, 1, *m_atlasSets[a], nullptr);
+    cmd.pushConstants(
+      m_layout,
+      vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+      0,
+      vk::ArrayProxy<const char>(sizeof(ImpostorConstants), reinterpret_cast<const char *>(&constants))
+    );
+    cmd.draw(6, count, 0, m_atlases[a].first);
+  }
+}
+
+void ImpostorManager::createAtlases(const Engine& engine) {
+  unsigned int maxDimension = engine.m_context.gpu().getProperties().limits.maxImageDimension2D;
+
+  for (const auto& [material, obj] : engine.m_objects.m_objects) {
+    unsigned int tiles = obj.commands.size() * m_views;
+    unsigned int columns = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<float>(tiles))));
+    unsigned int rows = (tiles + columns - 1) / columns;
+
+    if (columns * m_resolution > maxDimension || rows * m_resolution > maxDimension)
+      throw std::runtime_error("groot-engine: impostor atlas exceeds maximum image dimension");
+
+    Atlas& atlas = m_atlases.emplace_back();
+    atlas.material = material;
+    atlas.first = m_instanceCount;
+    atlas.columns = columns;
+    atlas.rows = rows;
+
+    for (unsigned int i = 0; i < obj.commands.size(); ++i)
+      atlas.objects.emplace_back(obj.transformIndex + i);
+    m_instanceCount += obj.commands.size();
+
+    auto [tmp_aMem, tmp_aImg, tmp_aView] = Allocator::imageResources(engine, vk::ImageCreateInfo{
+      .imageType  = vk::ImageType::e2D,
+      .format     = engine.m_settings.format,
+      .extent     = {
+        .width  = columns * m_resolution,
+        .height = rows * m_resolution,
+        .depth  = 1
+      },
+      .mipLevels    = 1,
+      .arrayLayers  = 1,
+      .samples      = vk::SampleCountFlagBits::e1,
+      .tiling       = vk::ImageTiling::eOptimal,
+      .usage        = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eSampled,
+      .sharingMode  = vk::SharingMode::eExclusive
+    }, vk::ImageAspectFlagBits::eColor);
+    atlas.memory = std::move(tmp_aMem);
+    atlas.image = std::move(tmp_aImg);
+    atlas.view = std::move(tmp_aView);
+  }
+}
+
+void ImpostorManager::bakeAtlases(const Engine& engine) {
+  vk::Extent2D depthExtent{ 1, 1 };
+  for (const auto& atlas : m_atlases) {
+    depthExtent.width = std::max(depthExtent.width, atlas.columns * m_resolution);
+    depthExtent.height = std::max(depthExtent.height, atlas.rows * m_resolution);
+  }
+
+  auto [depthMemory, depthImage, depthView] = Allocator::imageResources(engine, vk::ImageCreateInfo{
+    .imageType  = vk::ImageType::e2D,
+    .format     = engine.m_settings.depth_format,
+    .extent     = {
+      .width  = depthExtent.width,
+      .height = depthExtent.height,
+      .depth  = 1
+    },
+    .mipLevels    = 1,
+    .arrayLayers  = 1,
+    .samples      = vk::SampleCountFlagBits::e1,
+    .tiling       = vk::ImageTiling::eOptimal,
+    .usage        = vk::ImageUsageFlagBits::eDepthStencilAttachment,
+    .sharingMode  = vk::SharingMode::eExclusive
+  }, vk::ImageAspectFlagBits::eDepth);
+
+  unsigned int tiles = 0;
+  for (const Atlas& atlas : m_atlases)
+    tiles += atlas.columns * atlas.rows;
+
+  unsigned int alignment = engine.m_context.gpu().getProperties().limits.minUniformBufferOffsetAlignment;
+  unsigned int cameraStride = (sizeof(CameraData) + alignment - 1) / alignment * alignment;
+
+  auto [cameraMem, cameraBufs, _o, cameraSize] = Allocator::bufferPool(engine, {
+      vk::BufferCreateInfo{
+        .size         = tiles * cameraStride,
+        .usage        = vk::BufferUsageFlagBits::eUniformBuffer,
+        .sharingMode  = vk::SharingMode::eExclusive
+      }
+    },
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  void * cameraMap = cameraMem.mapMemory(0, cameraSize);
+
+  auto [cameraPool, cameraSets] = Allocator::descriptorPool(engine, engine.m_materials.cameraSetLayout(), 1, {
+    vk::DescriptorPoolSize{
+      .type             = vk::DescriptorType::eUniformBufferDynamic,
+      .descriptorCount  = 1
+    }
+  });
+
+  vk::DescriptorBufferInfo cameraInfo{
+    .buffer = cameraBufs[0],
+    .range  = sizeof(CameraData)
+  };
+
+  engine.m_context.device().updateDescriptorSets(vk::WriteDescriptorSet{
+    .dstSet           = cameraSets[0],
+    .dstBinding       = 0,
+    .descriptorCount  = 1,
+    .descriptorType   = vk::DescriptorType::eUniformBufferDynamic,
+    .pBufferInfo      = &cameraInfo
+  }, nullptr);
+
+  vk::DescriptorSet sets[2] = { *engine.m_materials.descriptorSet(0), *cameraSets[0] };
+  unsigned int slot = 0;
+
+  vk::raii::CommandBuffer cmd = std::move(engine.getCmds(QueueFamilyType::Main, 1)[0]);
+  cmd.begin({ .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+
+  unsigned int materialIndex = 0;
+  for (const auto& [material, pipeline] : engine.m_materials) {
+    unsigned int index = materialIndex++;
+
+    auto atlas = std::find_if(m_atlases.begin(), m_atlases.end(),
+      [&material](const Atlas& a) { return a.material == material; }
+    );
+    if (atlas == m_atlases.end()) continue;
+
+    const ObjectManager::ObjectData& obj = engine.m_objects.m_objects.at(material);
+    vk::Extent2D extent{ atlas->columns * m_resolution, atlas->rows * m_resolution };
+
+    vk::ImageMemoryBarrier barriers[2] = {
+      vk::ImageMemoryBarrier{
+        .dstAccessMask    = vk::AccessFlagBits::eColorAttachmentWrite,
+        .oldLayout        = vk::ImageLayout::eUndefined,
+        .newLayout        = vk::ImageLayout::eColorAttachmentOptimal,
+        .image            = atlas->image,
+        .subresourceRange = {
+          .aspectMask = vk::ImageAspectFlagBits::eColor,
+          .levelCount = 1,
+          .layerCount = 1
+        }
+      },
+      vk::ImageMemoryBarrier{
+        .srcAccessMask    = vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+        .dstAccessMask    = vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+        .oldLayout        = vk::ImageLayout::eUndefined,
+        .newLayout        = vk::ImageLayout::eDepthStencilAttachmentOptimal,
+        .image            = depthImage,
+        .subresourceRange = {
+          .aspectMask = vk::ImageAspectFlagBits::eDepth,
+          .levelCount = 1,
+          .layerCount = 1
+        }
+      }
+    };
+
+    cmd.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTopOfPipe | vk::PipelineStageFlagBits::eLateFragmentTests,
+      vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eEarlyFragmentTests,
+      vk::DependencyFlags(),
+      nullptr,
+      nullptr,
+      barriers
+    );
+
+    vk::RenderingAttachmentInfo color{
+      .imageView    = atlas->view,
+      .imageLayout  = vk::ImageLayout::eColorAttachmentOptimal,
+      .loadOp       = vk::AttachmentLoadOp::eClear,
+      .storeOp      = vk::AttachmentStoreOp::eStore,
+      .clearValue   = { std::array<float, 4>{ 0.0f, 0.0f, 0.0f, 0.0f } }
+    };
+
+    vk::RenderingAttachmentInfo depth{
+      .imageView    = depthView,
+      .imageLayout  = vk::ImageLayout::eDepthAttachmentOptimal,
+      .loadOp       = vk::AttachmentLoadOp::eClear,
+      .storeOp      = vk::AttachmentStoreOp::eDontCare,
+      .clearValue   = { .depthStencil = { 1, 0 } }
+    };
+
+    cmd.beginRendering(vk::RenderingInfo{
+      .renderArea = {
+        .extent = extent
+      },
+      .layerCount           = 1,
+      .colorAttachmentCount = 1,
+      .pColorAttachments    = &color,
+      .pDepthAttachment     = &depth
+    });
+
+    std::vector<const vk::raii::Pipeline *> passes;
+    if (engine.m_materials.prepass(material))
+      passes.emplace_back(&engine.m_materials.depthPipeline(material));
+    passes.emplace_back(&pipeline);
+
+    const auto& [vertexBuffer, indexBuffer, _i, vertexSet, indexType, _c, _t, _b] = engine.m_objects.staticObjects(material, 0);
+
+    if (engine.m_materials.vertexPulling(material))
+      cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, engine.m_materials.layout(), 2, *vertexSet, nullptr);
+    else
+      cmd.bindVertexBuffers(0, *vertexBuffer, { 0 });
+
+    cmd.bindIndexBuffer(indexBuffer, 0, indexType);
+
+    for (unsigned int i = 0; i < obj.commands.size(); ++i) {
+      const auto& command = obj.commands[i];
+      const Bounds& bounds = obj.bounds[i];
+
+      std::optional<mat4> inverse = engine.m_objects.m_transforms[obj.transformIndex + i].inverse();
+      if (!inverse) continue;
+
+      float radius = std::max(bounds.radius, std::numeric_limits<float>::epsilon());
+      mat4 projection(
+        vec4(1.0f / radius, 0.0f, 0.0f, 0.0f),
+        vec4(0.0f, 1.0f / radius, 0.0f, 0.0f),
+        vec4(0.0f, 0.0f, 0.5f / radius, -0.5f),
+        vec4(0.0f, 0.0f, 0.0f, 1.0f)
+      );
+
+      for (unsigned int v = 0; v < m_views; ++v) {
+        float angle = 2.0f * std::numbers::pi_v<float> * v / m_views;
+        vec3 direction(std::sin(angle), 0.0f, std::cos(angle));
+        unsigned int tile = i * m_views + v;
+
+        CameraData camera = CameraData::compute(
+          mat4::view(bounds.center + direction * (2.0f * radius), bounds.center, vec3(0.0f, -1.0f, 0.0f)) * *inverse,
+          projection
+        );
+        memcpy(reinterpret_cast<char *>(cameraMap) + slot * cameraStride, &camera, sizeof(CameraData));
+
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, engine.m_materials.layout(), 0, sets, slot * cameraStride);
+        ++slot;
+
+        EngineData engineData{
+          .frameIndex     = 0,
+          .materialIndex  = index,
+          .transformIndex = obj.transformIndex
+        };
+
+        cmd.setViewport(0, vk::Viewport{
+          .x        = static_cast<float>((tile % atlas->columns) * m_resolution),
+          .y        = static_cast<float>((tile / atlas->columns) * m_resolution),
+          .width    = static_cast<float>(m_resolution),
+          .height   = static_cast<float>(m_resolution),
+          .minDepth = 0,
+          .maxDepth = 1
+        });
+
+        cmd.setScissor(0, vk::Rect2D{
+          .offset = {
+            .x = static_cast<int>((tile % atlas->columns) * m_resolution),
+            .y = static_cast<int>((tile / atlas->columns) * m_resolution)
+          },
+          .extent = { m_resolution, m_resolution }
+        });
+
+        cmd.pushConstants(
+          engine.m_materials.layout(),
+          all_stages,
+          0,
+          vk::ArrayProxy<const char>(sizeof(EngineData), reinterpret_cast<const char *>(&engineData))
+        );
+
+        for (const vk::raii::Pipeline * pass : passes) {
+          cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pass);
+          cmd.drawIndexed(command.indexCount, 1, command.firstIndex, command.vertexOffset, command.firstInstance);
+        }
+      }
+    }
+
+    cmd.endRendering();
+
+    barriers[0].srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+    barriers[0].dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    barriers[0].oldLayout = vk::ImageLayout::eColorAttachmentOptimal;
+    barriers[0].newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+
+    cmd.pipelineBarrier(
+      vk::PipelineStageFlagBits::eColorAttachmentOutput,
+      vk::PipelineStageFlagBits::eFragmentShader,
+      vk::DependencyFlags(),
+      nullptr,
+      nullptr,
+      barriers[0]
+    );
+  }
+
+  cmd.end();
+
+  vk::SubmitInfo bakeSubmit{
+    .commandBufferCount = 1,
+    .pCommandBuffers    = &*cmd
+  };
+
+  vk::raii::Fence bakeFence = std::move(Allocator::fences(engine, 1)[0]);
+
+  engine.m_context.queueFamily(QueueFamilyType::Main).queue.submit(bakeSubmit, bakeFence);
+
+  if (engine.m_context.device().waitForFences(*bakeFence, true, ge_timeout) != vk::Result::eSuccess)
+    throw std::runtime_error("groot-engine: hung waiting for impostor atlas bake");
+}
+
+void ImpostorManager::createLayout(const Engine& engine) {
+  vk::DescriptorSetLayoutBinding instanceBinding{
+    .binding          = 0,
+    .descriptorType   = vk::DescriptorType::eStorageBuffer,
+    .descriptorCount  = 1,
+    .stageFlags       = vk::ShaderStageFlagBits::eVertex
+  };
+
+  m_instanceSetLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .bindingCount = 1,
+    .pBindings    = &instanceBinding
+  });
+
+  vk::DescriptorSetLayoutBinding atlasBinding{
+    .binding          = 0,
+    .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+    .descriptorCount  = 1,
+    .stageFlags       = vk::ShaderStageFlagBits::eFragment
+  };
+
+  m_atlasSetLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .bindingCount = 1,
+    .pBindings    = &atlasBinding
+  });
+
+  vk::DescriptorSetLayout setLayouts[2] = { *m_instanceSetLayout, *m_atlasSetLayout };
+
+  vk::PushConstantRange range{
+    .stageFlags = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+    .size       = sizeof(ImpostorConstants)
+  };
+
+  m_layout = engine.m_context.device().createPipelineLayout(vk::PipelineLayoutCreateInfo{
+    .setLayoutCount         = 2,
+    .pSetLayouts            = setLayouts,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &range
+  });
+
+  m_sampler = engine.m_context.device().createSampler(vk::SamplerCreateInfo{
+    .magFilter    = vk::Filter::eLinear,
+    .minFilter    = vk::Filter::eLinear,
+    .mipmapMode   = vk::SamplerMipmapMode::eNearest,
+    .addressModeU = vk::SamplerAddressMode::eClampToEdge,
+    .addressModeV = vk::SamplerAddressMode::eClampToEdge,
+    .addressModeW = vk::SamplerAddressMode::eClampToEdge
+  });
+}
+
+void ImpostorManager::createPipeline(const Engine& engine) {
+  vk::raii::ShaderModule vertModule = engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
+    .codeSize = sizeof(impostorVertCode),
+    .pCode    = impostorVertCode
+  });
+
+  vk::raii::ShaderModule fragModule = engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
+    .codeSize = sizeof(impostorFragCode),
+    .pCode    = impostorFragCode
+  });
+
+  vk::PipelineShaderStageCreateInfo ci_stages[2] = {
+    vk::PipelineShaderStageCreateInfo{
+      .stage  = vk::ShaderStageFlagBits::eVertex,
+      .module = vertModule,
+      .pName  = "main"
+    },
+    vk::PipelineShaderStageCreateInfo{
+      .stage  = vk::ShaderStageFlagBits::eFragment,
+      .module = fragModule,
+      .pName  = "main"
+    }
+  };
+
+  vk::DynamicState dynStates[2] = {
+    vk::DynamicState::eViewport,
+    vk::DynamicState::eScissor
+  };
+
+  vk::PipelineDynamicStateCreateInfo ci_dynState{
+    .dynamicStateCount  = 2,
+    .pDynamicStates     = dynStates
+  };
+
+  vk::PipelineViewportStateCreateInfo ci_viewport{
+    .viewportCount  = 1,
+    .scissorCount   = 1
+  };
+
+  vk::PipelineVertexInputStateCreateInfo ci_input{};
+
+  vk::PipelineInputAssemblyStateCreateInfo ci_assembly{
+    .topology               = vk::PrimitiveTopology::eTriangleList,
+    .primitiveRestartEnable = false
+  };
+
+  vk::PipelineRasterizationStateCreateInfo ci_rasterizer{
+    .depthClampEnable         = false,
+    .rasterizerDiscardEnable  = false,
+    .polygonMode              = vk::PolygonMode::eFill,
+    .cullMode                 = vk::CullModeFlagBits::eNone,
+    .frontFace                = vk::FrontFace::eCounterClockwise,
+    .depthBiasEnable          = false,
+    .lineWidth                = 1.0f
+  };
+
+  vk::PipelineMultisampleStateCreateInfo ci_multisample{
+    .rasterizationSamples = vk::SampleCountFlagBits::e1,
+    .sampleShadingEnable  = false
+  };
+
+  vk::PipelineDepthStencilStateCreateInfo ci_depth{
+    .depthTestEnable        = true,
+    .depthWriteEnable       = true,
+    .depthCompareOp         = vk::CompareOp::eLess,
+    .depthBoundsTestEnable  = false,
+    .stencilTestEnable      = false
+  };
+
+  vk::PipelineColorBlendAttachmentState colorAttachment{
+    .blendEnable          = false,
+    .colorWriteMask       = vk::ColorComponentFlagBits::eR |
+                            vk::ColorComponentFlagBits::eG |
+                            vk::ColorComponentFlagBits::eB |
+                            vk::ColorComponentFlagBits::eA
+  };
+
+  vk::PipelineColorBlendStateCreateInfo ci_blend{
+    .logicOpEnable    = false,
+    .attachmentCount  = 1,
+    .pAttachments     = &colorAttachment
+  };
+
+  vk::PipelineRenderingCreateInfo ci_rendering{
+    .colorAttachmentCount     = 1,
+    .pColorAttachmentFormats  = &engine.m_settings.format,
+    .depthAttachmentFormat    = engine.m_settings.depth_format
+  };
+
+  m_pipeline = engine.m_pipelineCache.createGraphicsPipeline(engine, vk::GraphicsPipelineCreateInfo{
+    .pNext                = &ci_rendering,
+    .stageCount           = 2,
+    .pStages              = ci_stages,
+    .pVertexInputState    = &ci_input,
+    .pInputAssemblyState  = &ci_assembly,
+    .pViewportState       = &ci_viewport,
+    .pRasterizationState  = &ci_rasterizer,
+    .pMultisampleState    = &ci_multisample,
+    .pDepthStencilState   = &ci_depth,
+    .pColorBlendState     = &ci_blend,
+    .pDynamicState        = &ci_dynState,
+    .layout               = m_layout
+  });
+}
+
+void ImpostorManager::createBuffers(const Engine& engine) {
+  std::vector<vk::BufferCreateInfo> instanceInfos;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    instanceInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = static_cast<unsigned int>(sizeof(Instance) * m_instanceCount),
+      .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+  }
+
+  auto [tmp_instanceMem, tmp_instanceBufs, tmp_instanceOffs, instanceSize] = Allocator::bufferPool(engine, instanceInfos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_instanceMemory = std::move(tmp_instanceMem);
+  m_instanceBuffers = std::move(tmp_instanceBufs);
+  m_instanceOffsets = std::move(tmp_instanceOffs);
+
+  m_instanceMap = m_instanceMemory.mapMemory(0, instanceSize);
+  m_counts.assign(engine.m_settings.buffer_mode * m_atlases.size(), 0);
+}
+
+void ImpostorManager::updateSets(const Engine& engine) {
+  std::vector<vk::DescriptorBufferInfo> bufferInfos;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i)
+    bufferInfos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_instanceBuffers[i], .range = vk::WholeSize });
+
+  std::vector<vk::DescriptorImageInfo> imageInfos;
+  for (const auto& atlas : m_atlases) {
+    imageInfos.emplace_back(vk::DescriptorImageInfo{
+      .sampler      = m_sampler,
+      .imageView    = atlas.view,
+      .imageLayout  = vk::ImageLayout::eShaderReadOnlyOptimal
+    });
+  }
+
+  std::vector<vk::WriteDescriptorSet> writes;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = m_instanceSets[i],
+      .dstBinding       = 0,
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .pBufferInfo      = &bufferInfos[i]
+    });
+  }
+
+  for (unsigned int i = 0; i < m_atlases.size(); ++i) {
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = m_atlasSets[i],
+      .dstBinding       = 0,
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+      .pImageInfo       = &imageInfos[i]
+    });
+  }
+
+  engine.m_context.device().updateDescriptorSets(writes, nullptr);
+}
+
+} // namespace ge
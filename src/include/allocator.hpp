@@ -27,6 +27,12 @@ class Allocator {
     vk::raii::ImageView
   >;
 
+  using ImageOutput = std::tuple<
+    vk::raii::DeviceMemory,
+    vk::raii::Image,
+    vk::raii::ImageView
+  >;
+
   using FenceOutput = std::vector<vk::raii::Fence>;
   using SemaphoreOutput = std::vector<vk::raii::Semaphore>;
 
@@ -48,9 +54,23 @@ class Allocator {
     static BufferOutput bufferPool(const Engine&, const std::vector<vk::BufferCreateInfo>&, vk::MemoryPropertyFlags);
     static CommandOutput commandPools(const Engine&);
     static DepthOutput depthResources(const Engine&);
+    static ImageOutput imageResources(const Engine&, const vk::ImageCreateInfo&, vk::ImageAspectFlags);
     static FenceOutput fences(const Engine&, unsigned int, bool signaled = false);
     static SemaphoreOutput semaphores(const Engine&, unsigned int);
-    static DescriptorOutput descriptorPool(const Engine&, const vk::raii::DescriptorSetLayout&);
+    static DescriptorOutput descriptorPool(
+      const Engine&,
+      const vk::raii::DescriptorSetLayout&,
+      unsigned int,
+      unsigned int descriptors = 1
+    );
+    static DescriptorOutput descriptorPool(
+      const Engine&,
+      const vk::raii::DescriptorSetLayout&,
+      unsigned int,
+      const std::vector<vk::DescriptorPoolSize>&,
+      vk::DescriptorPoolCreateFlags flags = {},
+      unsigned int variableCount = 0
+    );
 
   private:
     static vk::raii::DeviceMemory allocate(
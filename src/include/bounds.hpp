@@ -0,0 +1,74 @@
+#pragma once
+
+#include "src/include/linalg.hpp"
+#include "src/include/vertex.hpp"
+
+#include <vector>
+
+namespace ge {
+
+enum BoundsComponent {
+  CenterX,
+  CenterY,
+  CenterZ,
+  Radius,
+  MinX,
+  MinY,
+  MinZ,
+  MaxX,
+  MaxY,
+  MaxZ,
+  BoundsComponents
+};
+
+class Bounds {
+  public:
+    Bounds() = default;
+    Bounds(const Bounds&) = default;
+    Bounds(Bounds&&) = default;
+    Bounds(const vec3&, const vec3&);
+
+    ~Bounds() = default;
+
+    Bounds& operator=(const Bounds&) = default;
+    Bounds& operator=(Bounds&&) = default;
+
+    static Bounds compute(const std::vector<Vertex>&);
+    static Bounds compute(const Vertex *, unsigned int);
+
+    Bounds transformed(const mat4&) const;
+
+  public:
+    vec3 min = vec3(0.0f);
+    vec3 max = vec3(0.0f);
+    vec3 center = vec3(0.0f);
+    float radius = 0.0f;
+};
+
+class BoundsArray {
+  public:
+    BoundsArray() = default;
+    BoundsArray(const BoundsArray&) = default;
+    BoundsArray(BoundsArray&&) = default;
+
+    ~BoundsArray() = default;
+
+    BoundsArray& operator=(const BoundsArray&) = default;
+    BoundsArray& operator=(BoundsArray&&) = default;
+
+    Bounds operator[](unsigned int) const;
+
+    unsigned int size() const;
+    unsigned int bytes() const;
+    const float * data() const;
+    const float * component(BoundsComponent) const;
+
+    void resize(unsigned int);
+    void set(unsigned int, const Bounds&);
+
+  private:
+    unsigned int m_count = 0;
+    std::vector<float> m_data;
+};
+
+} // namespace ge
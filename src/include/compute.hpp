@@ -0,0 +1,147 @@
+#pragma once
+
+#include "src/include/culling.hpp"
+#include "src/include/linalg.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <array>
+#include <vector>
+
+namespace ge {
+
+class Engine;
+class ObjectManager;
+
+struct CullingStatistics {
+  unsigned int commands = 0;
+  std::array<unsigned int, 2> visible = { 0, 0 };
+};
+
+class ComputeManager {
+  private:
+    struct CullConstants {
+      std::array<vec4, 6> planes = {
+        vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f)
+      };
+      unsigned int objectCount = 0;
+    };
+
+    struct ClusterConstants {
+      std::array<vec4, 6> planes = {
+        vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f)
+      };
+      vec4 camera = vec4(0.0f);
+      unsigned int clusterCount = 0;
+    };
+
+    struct OcclusionConstants {
+      unsigned int objectCount = 0;
+      unsigned int batchCount = 0;
+      unsigned int phase = 0;
+      unsigned int occlusion = 0;
+    };
+
+    struct CullView {
+      std::array<vec4, 6> planes = {
+        vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f)
+      };
+      mat4 viewProjection = mat4::identity();
+      mat4 previousViewProjection = mat4::identity();
+    };
+
+  public:
+    ComputeManager() = default;
+    ComputeManager(ComputeManager&) = delete;
+    ComputeManager(ComputeManager&&) = delete;
+
+    ~ComputeManager() = default;
+
+    ComputeManager& operator=(ComputeManager&) = delete;
+    ComputeManager& operator=(ComputeManager&&) = delete;
+
+    const vk::raii::Buffer& drawBuffer(unsigned int) const;
+    const vk::raii::Buffer& countBuffer(unsigned int) const;
+    unsigned int drawOffset(unsigned int) const;
+    unsigned int countOffset(unsigned int) const;
+    CullingStatistics statistics(unsigned int) const;
+
+    void load(const Engine&);
+    void updateCullData(unsigned int, const ObjectManager&);
+    void cull(const vk::raii::CommandBuffer&, unsigned int, const mat4&, const vec3&, unsigned int phase = 0);
+    void buildPyramid(const vk::raii::CommandBuffer&, const vk::raii::Image&);
+    void readCounts(const vk::raii::CommandBuffer&, unsigned int) const;
+
+  private:
+    void createLayout(const Engine&);
+    void createPipeline(const Engine&);
+    void createBuffers(const Engine&);
+    void createPyramid(const Engine&);
+    void updateSets(const Engine&);
+
+  private:
+    bool m_occlusion = false;
+    bool m_clusters = false;
+    bool m_pyramidReady = false;
+    unsigned int m_objectCount = 0;
+    unsigned int m_batchCount = 0;
+    unsigned int m_commandSize = 0;
+    std::vector<unsigned int> m_cullVersions;
+    mat4 m_previousViewProjection = mat4::identity();
+
+    vk::raii::DescriptorSetLayout m_setLayout = nullptr;
+    vk::raii::PipelineLayout m_layout = nullptr;
+    vk::raii::Pipeline m_cullPipeline = nullptr;
+
+    vk::raii::DescriptorSetLayout m_occlusionSetLayout = nullptr;
+    vk::raii::PipelineLayout m_occlusionLayout = nullptr;
+    vk::raii::Pipeline m_occlusionPipeline = nullptr;
+
+    vk::raii::DescriptorSetLayout m_pyramidSetLayout = nullptr;
+    vk::raii::PipelineLayout m_pyramidLayout = nullptr;
+    vk::raii::Pipeline m_pyramidPipeline = nullptr;
+
+    vk::raii::DescriptorPool m_setPool = nullptr;
+    vk::raii::DescriptorSets m_sets = nullptr;
+
+    vk::raii::DescriptorPool m_occlusionSetPool = nullptr;
+    vk::raii::DescriptorSets m_occlusionSets = nullptr;
+
+    vk::raii::DescriptorPool m_pyramidSetPool = nullptr;
+    vk::raii::DescriptorSets m_pyramidSets = nullptr;
+
+    vk::raii::DeviceMemory m_cullMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_cullBuffers;
+    std::vector<unsigned int> m_cullOffsets;
+    void * m_cullMap = nullptr;
+
+    vk::raii::DeviceMemory m_drawMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_drawBuffers;
+
+    vk::raii::DeviceMemory m_countMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_countBuffers;
+
+    vk::raii::DeviceMemory m_readbackMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_readbackBuffers;
+    std::vector<unsigned int> m_readbackOffsets;
+    void * m_readbackMap = nullptr;
+
+    vk::raii::DeviceMemory m_visibilityMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_visibilityBuffers;
+
+    vk::raii::DeviceMemory m_viewMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_viewBuffers;
+    std::vector<unsigned int> m_viewOffsets;
+    void * m_viewMap = nullptr;
+
+    vk::Extent2D m_pyramidExtent;
+    unsigned int m_pyramidLevels = 0;
+    vk::raii::DeviceMemory m_pyramidMemory = nullptr;
+    vk::raii::Image m_pyramid = nullptr;
+    vk::raii::ImageView m_pyramidView = nullptr;
+    std::vector<vk::raii::ImageView> m_pyramidLevelViews;
+    vk::raii::Sampler m_pyramidSampler = nullptr;
+};
+
+} // namespace ge
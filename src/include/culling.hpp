@@ -0,0 +1,66 @@
+#pragma once
+
+#include "src/include/bounds.hpp"
+#include "src/include/linalg.hpp"
+
+#include <array>
+
+namespace ge {
+
+enum CullingMode {
+  NoCulling,
+  CPUCulling,
+  GPUCulling,
+  OcclusionCulling,
+  SoftwareOcclusionCulling,
+  ClusterCulling
+};
+
+struct CullData {
+  vec4 sphere = vec4(0.0f);
+  vec4 boxMin = vec4(0.0f);
+  vec4 boxMax = vec4(0.0f);
+  unsigned int batch = 0;
+  unsigned int first = 0;
+  unsigned int padding[2] = { 0, 0 };
+};
+
+static_assert(sizeof(CullData) == 64, "CullData must match the std430 stride of cull.comp");
+
+struct ClusterData {
+  vec4 sphere = vec4(0.0f);
+  vec4 cone = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+  unsigned int object = 0;
+  unsigned int batch = 0;
+  unsigned int first = 0;
+  unsigned int firstIndex = 0;
+  unsigned int indexCount = 0;
+  unsigned int padding[3] = { 0, 0, 0 };
+};
+
+static_assert(sizeof(ClusterData) == 64, "ClusterData must match the std430 stride of cluster.comp");
+
+class Frustum {
+  public:
+    Frustum() = delete;
+    Frustum(const Frustum&) = default;
+    Frustum(Frustum&&) = default;
+    explicit Frustum(const mat4&);
+
+    ~Frustum() = default;
+
+    Frustum& operator=(const Frustum&) = default;
+    Frustum& operator=(Frustum&&) = default;
+
+    const std::array<vec4, 6>& planes() const;
+
+    bool intersects(const Bounds&) const;
+    void cull(const BoundsArray&, unsigned int, unsigned int, unsigned char *) const;
+
+  private:
+    std::array<vec4, 6> m_planes = {
+      vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f)
+    };
+};
+
+} // namespace ge
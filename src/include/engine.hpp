@@ -1,9 +1,13 @@
 #pragma once
 
+#include "src/include/compute.hpp"
+#include "src/include/impostors.hpp"
 #include "src/include/materials.hpp"
 #include "src/include/objects.hpp"
+#include "src/include/pipelines.hpp"
 #include "src/include/renderer.hpp"
 #include "src/include/vkcontext.hpp"
+#include "src/include/workers.hpp"
 
 #include <GLFW/glfw3.h>
 
@@ -34,6 +38,20 @@ struct Settings {
   BufferMode buffer_mode = TripleBuffer;
   vk::Format format = vk::Format::eB8G8R8A8Srgb;
   vk::Format depth_format = vk::Format::eD32Sfloat;
+  VertexFormat vertex_format = StandardVertices;
+  CullingMode culling_mode = NoCulling;
+  vk::Extent2D occlusion_extent = vk::Extent2D{ 256, 128 };
+  unsigned int lod_levels = 1;
+  float lod_screen_size = 0.25f;
+  float impostor_distance = 0.0f;
+  unsigned int impostor_views = 8;
+  unsigned int impostor_resolution = 128;
+  bool depth_prepass = false;
+  std::string pipeline_cache_path = "";
+  bool pipeline_libraries = true;
+  bool async_materials = false;
+  bool headless = false;
+  bool headless_surface = false;
   vk::ColorSpaceKHR color_space = vk::ColorSpaceKHR::eSrgbNonlinear;
   vk::PresentModeKHR present_mode = vk::PresentModeKHR::eMailbox;
   vk::Extent2D extent = vk::Extent2D{ 1280, 720 };
@@ -43,9 +61,13 @@ struct Settings {
 
 class Engine {
   friend class Allocator;
+  friend class ComputeManager;
+  friend class ImpostorManager;
   friend class MaterialManager;
   friend class ObjectManager;
+  friend class PipelineCache;
   friend class Renderer;
+  friend class TextureManager;
   friend class VulkanContext;
 
   public:
@@ -62,13 +84,26 @@ class Engine {
 
     void add_material(std::string, const MaterialManager::Builder&);
     void add_material(std::string, MaterialManager::Builder&&);
+    void add_texture(std::string, unsigned int, unsigned int, const std::vector<unsigned char>&);
     transform add_object(std::string, std::string, const Transform& t = Transform());
+    transform add_dynamic_object(std::string, std::string, const Transform& t = Transform());
+    void set_parameter(std::string, std::string, const ParameterValue&);
+    void set_parameter(const transform&, std::string, const ParameterValue&);
+    void update_vertices(const transform&, unsigned int, const std::vector<Vertex>&);
+    void set_occluder(const transform&, bool occluder = true);
+    Bounds bounds(const transform&) const;
+    OptimizationReport optimization_report(const transform&) const;
+    PipelineCacheStatistics pipeline_cache_statistics() const;
+    CullingStatistics culling_statistics() const;
+    void render_frame();
+    void close();
     void run();
 
     template <typename Func>
     requires std::invocable<Func>
     inline void run(Func&& code) {
-      load();
+      if (!m_loaded)
+        load();
 
       std::chrono::time_point start = std::chrono::high_resolution_clock::now();
       std::chrono::time_point now = start;
@@ -92,7 +127,8 @@ class Engine {
     template <typename Func>
     requires std::invocable<Func, double>
     inline void run(Func&& code) {
-      load();
+      if (!m_loaded)
+        load();
 
       std::chrono::time_point start = std::chrono::high_resolution_clock::now();
       std::chrono::time_point now = start;
@@ -131,10 +167,18 @@ class Engine {
     double m_frameTime = 0.0;
     double m_currTime = 0.0;
     double m_accumulator = 0.0;
+    bool m_loaded = false;
+    bool m_closing = false;
 
     VulkanContext m_context;
+    PipelineCache m_pipelineCache;
+    TextureManager m_textures;
     MaterialManager m_materials;
     ObjectManager m_objects;
+    ComputeManager m_compute;
+    ImpostorManager m_impostors;
+    OcclusionBuffer m_occlusion;
+    WorkerPool m_workers;
 
     GLFWwindow * m_window = nullptr;
     vk::raii::SurfaceKHR m_surface = nullptr;
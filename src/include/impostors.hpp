@@ -0,0 +1,94 @@
+#pragma once
+
+#include "src/include/linalg.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <string>
+#include <vector>
+
+namespace ge {
+
+class Engine;
+class ObjectManager;
+
+class ImpostorManager {
+  private:
+    struct Instance {
+      vec4 sphere = vec4(0.0f);
+      unsigned int tile = 0;
+      unsigned int padding[3] = { 0, 0, 0 };
+    };
+
+    struct ImpostorConstants {
+      mat4 viewProjection = mat4::identity();
+      vec4 right = vec4(0.0f);
+      vec4 up = vec4(0.0f);
+      unsigned int columns = 0;
+      unsigned int rows = 0;
+      unsigned int padding[2] = { 0, 0 };
+    };
+
+    struct Atlas {
+      std::string material;
+      unsigned int first = 0;
+      unsigned int columns = 0;
+      unsigned int rows = 0;
+      std::vector<unsigned int> objects;
+
+      vk::raii::DeviceMemory memory = nullptr;
+      vk::raii::Image image = nullptr;
+      vk::raii::ImageView view = nullptr;
+    };
+
+  public:
+    ImpostorManager() = default;
+    ImpostorManager(ImpostorManager&) = delete;
+    ImpostorManager(ImpostorManager&&) = delete;
+
+    ~ImpostorManager() = default;
+
+    ImpostorManager& operator=(ImpostorManager&) = delete;
+    ImpostorManager& operator=(ImpostorManager&&) = delete;
+
+    void load(const Engine&);
+    void update(unsigned int, ObjectManager&, const vec3&);
+    void draw(const vk::raii::CommandBuffer&, unsigned int, const mat4&, const mat4&) const;
+
+  private:
+    void createAtlases(const Engine&);
+    void bakeAtlases(const Engine&);
+    void createLayout(const Engine&);
+    void createPipeline(const Engine&);
+    void createBuffers(const Engine&);
+    void updateSets(const Engine&);
+
+  private:
+    float m_distance = 0.0f;
+    unsigned int m_views = 0;
+    unsigned int m_resolution = 0;
+    unsigned int m_instanceCount = 0;
+    bool m_cpuCulling = false;
+    std::vector<Atlas> m_atlases;
+    std::vector<unsigned int> m_counts;
+
+    vk::raii::DescriptorSetLayout m_instanceSetLayout = nullptr;
+    vk::raii::DescriptorSetLayout m_atlasSetLayout = nullptr;
+    vk::raii::PipelineLayout m_layout = nullptr;
+    vk::raii::Pipeline m_pipeline = nullptr;
+    vk::raii::Sampler m_sampler = nullptr;
+
+    vk::raii::DescriptorPool m_instanceSetPool = nullptr;
+    vk::raii::DescriptorSets m_instanceSets = nullptr;
+
+    vk::raii::DescriptorPool m_atlasSetPool = nullptr;
+    vk::raii::DescriptorSets m_atlasSets = nullptr;
+
+    vk::raii::DeviceMemory m_instanceMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_instanceBuffers;
+    std::vector<unsigned int> m_instanceOffsets;
+    void * m_instanceMap = nullptr;
+};
+
+} // namespace ge
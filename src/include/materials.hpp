@@ -1,12 +1,23 @@
 #pragma once
 
+#include "src/include/bounds.hpp"
 #include "src/include/linalg.hpp"
+#include "src/include/shaders.hpp"
+#include "src/include/textures.hpp"
 
 #include <vulkan/vulkan_raii.hpp>
 #include <vulkan/vulkan_beta.h>
 
+#include <array>
+#include <atomic>
+#include <compare>
+#include <deque>
+#include <future>
 #include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <tuple>
 
 #define all_stages  vk::ShaderStageFlagBits::eVertex                  | \
                     vk::ShaderStageFlagBits::eGeometry                | \
@@ -18,6 +29,7 @@
 namespace ge {
 
 class Engine;
+class Transform;
 
 enum ShaderStage {
   VertexShader = static_cast<unsigned int>(vk::ShaderStageFlagBits::eVertex),
@@ -28,24 +40,80 @@ enum ShaderStage {
   ComputeShader = static_cast<unsigned int>(vk::ShaderStageFlagBits::eCompute)
 };
 
-struct EngineData {
+enum BlendMode {
+  OpaqueBlending,
+  AlphaBlending,
+  AdditiveBlending
+};
+
+struct PipelineState {
+  vk::PrimitiveTopology topology = vk::PrimitiveTopology::eTriangleList;
+  vk::PolygonMode polygonMode = vk::PolygonMode::eFill;
+  vk::CullModeFlags cullMode = vk::CullModeFlagBits::eBack;
+  vk::FrontFace frontFace = vk::FrontFace::eCounterClockwise;
+  bool depthTest = true;
+  bool depthWrite = true;
+  vk::CompareOp depthCompare = vk::CompareOp::eLess;
+  BlendMode blendMode = OpaqueBlending;
+};
+
+enum ParameterType {
+  FloatParameter,
+  IntParameter,
+  UintParameter,
+  Vec2Parameter,
+  Vec3Parameter,
+  Vec4Parameter
+};
+
+struct ParameterValue {
+  ParameterType type = FloatParameter;
+  unsigned int words[4] = {};
+
+  ParameterValue(float);
+  ParameterValue(int);
+  ParameterValue(unsigned int);
+  ParameterValue(const vec2&);
+  ParameterValue(const vec3&);
+  ParameterValue(const vec4&);
+
+  unsigned int size() const;
+};
+
+struct CameraData {
   mat4 view = mat4::identity();
   mat4 projection = mat4::identity();
+  mat4 viewProjection = mat4::identity();
+  mat4 inverseView = mat4::identity();
+  mat4 inverseProjection = mat4::identity();
+  mat4 inverseViewProjection = mat4::identity();
+  vec4 position = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+  static CameraData compute(const mat4&, const mat4&);
+};
+
+struct EngineData {
   unsigned int frameIndex;
   unsigned int materialIndex;
   unsigned int transformIndex;
 };
 
 class MaterialManager {
-  using ShaderStages = std::pair<
-    std::vector<vk::raii::ShaderModule>,
-    std::vector<vk::PipelineShaderStageCreateInfo>
-  >;
+  using Constants = std::map<unsigned int, unsigned int>;
 
   public:
+    static constexpr unsigned int max_textures = 4;
+    static constexpr unsigned int max_parameters = 16;
+
     class Builder {
       friend class MaterialManager;
 
+      struct Parameter {
+        std::string name;
+        unsigned int column = 0;
+        ParameterValue value = 0.0f;
+      };
+
       public:
         Builder() = default;
         Builder(const Builder&) = default;
@@ -57,15 +125,73 @@ class MaterialManager {
         Builder& operator=(Builder&&) = default;
 
         Builder& add_shader(ShaderStage, std::string);
+        Builder& set_vertex_pulling(bool pulling = true);
+        Builder& set_blend_mode(BlendMode);
+        Builder& set_topology(vk::PrimitiveTopology);
+        Builder& set_polygon_mode(vk::PolygonMode);
+        Builder& set_cull_mode(vk::CullModeFlags, vk::FrontFace front = vk::FrontFace::eCounterClockwise);
+        Builder& set_depth_test(bool test = true, bool write = true, vk::CompareOp compare = vk::CompareOp::eLess);
+        Builder& set_constant(ShaderStage, unsigned int, bool);
+        Builder& set_constant(ShaderStage, unsigned int, int);
+        Builder& set_constant(ShaderStage, unsigned int, unsigned int);
+        Builder& set_constant(ShaderStage, unsigned int, float);
+        Builder& add_texture(std::string, SamplerType sampler = LinearRepeat);
+        Builder& set_parameter(std::string, const ParameterValue&);
+        Builder& set_object_parameter(std::string, const ParameterValue&);
+
+      private:
+        static void declare(std::vector<Parameter>&, const std::string&, const ParameterValue&);
+        static const Parameter& find(const std::vector<Parameter>&, const std::string&);
 
       private:
         std::map<vk::ShaderStageFlagBits, std::string> m_shaders;
+        std::map<vk::ShaderStageFlagBits, Constants> m_constants;
+        std::vector<std::pair<std::string, SamplerType>> m_textures;
+        std::vector<Parameter> m_parameters;
+        std::vector<Parameter> m_objectParameters;
+        bool m_vertexPulling = false;
+        PipelineState m_state;
     };
 
   private:
+    struct PipelineKey {
+      unsigned long long hash = 0;
+      std::string state;
+
+      auto operator<=>(const PipelineKey&) const = default;
+    };
+
+    struct MaterialData {
+      unsigned int textures[max_textures] = {};
+      unsigned int samplers[max_textures] = {};
+    };
+
+    struct ShaderStages {
+      std::vector<vk::PipelineShaderStageCreateInfo> infos;
+      std::vector<vk::SpecializationInfo> specializations;
+      std::vector<std::vector<vk::SpecializationMapEntry>> entries;
+      std::vector<std::vector<unsigned int>> data;
+    };
+
+    struct Libraries {
+      vk::Pipeline vertexInput = nullptr;
+      vk::Pipeline fragmentOutput = nullptr;
+      vk::raii::Pipeline preRasterization = nullptr;
+      vk::raii::Pipeline fragmentShader = nullptr;
+    };
+
+    struct CompileJob {
+      const Builder * builder = nullptr;
+      bool depthOnly = false;
+      unsigned int index = 0;
+    };
+
     struct Material {
       unsigned int builder = 0;
+      unsigned int index = 0;
       unsigned int pipeline = 0;
+      unsigned int depthPipeline = 0;
+      bool prepass = false;
     };
 
     class Iterator {
@@ -97,7 +223,7 @@ class MaterialManager {
     MaterialManager(MaterialManager&) = delete;
     MaterialManager(MaterialManager&&) = delete;
 
-    ~MaterialManager() = default;
+    ~MaterialManager();
 
     MaterialManager& operator=(MaterialManager&) = delete;
     MaterialManager& operator=(MaterialManager&&) = delete;
@@ -106,37 +232,140 @@ class MaterialManager {
     Iterator end() const;
 
     bool exists(std::string) const;
+    bool vertexPulling(std::string) const;
+    unsigned int index(std::string) const;
+    unsigned int pipelineCount() const;
+    bool prepass(std::string) const;
+    bool ready(std::string) const;
+    const std::set<std::string>& transparent() const;
+    const vk::raii::Pipeline& pipeline(std::string) const;
+    const vk::raii::Pipeline& depthPipeline(std::string) const;
     const vk::raii::PipelineLayout& layout() const;
+    const vk::raii::DescriptorSetLayout& cameraSetLayout() const;
+    const vk::raii::DescriptorSetLayout& vertexSetLayout() const;
     const vk::raii::DescriptorSet& descriptorSet(unsigned int) const;
+    const vk::raii::DescriptorSet& cameraSet() const;
+    unsigned int cameraOffset(unsigned int) const;
+    const vk::raii::Buffer& transformBuffer(unsigned int) const;
 
     void add(const std::string&, const Builder&);
     void add(const std::string&, Builder&&);
-    void load(const Engine&, const std::vector<mat4>&);
+    void load(const Engine&, const std::vector<mat4>&, const BoundsArray&, const std::map<const Transform *, std::string>&);
     void updateTransforms(const unsigned int&, const std::vector<mat4>&);
+    void updateBounds(const unsigned int&, const BoundsArray&);
+    void updateParameters(const unsigned int&);
+    void setParameter(const std::string&, const std::string&, const ParameterValue&);
+    void setParameter(const std::string&, const Transform *, const std::string&, const ParameterValue&);
+    void updatePipelines(const Engine&);
+    void waitPipelines(const Engine&);
+    void finishPipelines();
+    void updateTextures(const Engine&, unsigned int);
+    void updateCamera(unsigned int, const CameraData&);
+
+    static std::array<unsigned int, 3> parameterHeader(unsigned int);
+    static unsigned int materialParameter(unsigned int, unsigned int);
+    static unsigned int objectParameter(unsigned int, unsigned int, unsigned int);
 
   private:
     ShaderStages getShaderStages(const Engine&, const Builder&) const;
 
     void createLayout(const Engine&, unsigned int);
-    void createPipeline(const Engine&, const Builder&);
-    void createDescriptors(const Engine&, const std::vector<mat4>&);
+    bool usesPrepass(const Engine&, const Builder&) const;
+    PipelineState pipelineState(const Engine&, const Builder&, bool) const;
+    PipelineKey pipelineKey(const Engine&, const Builder&, bool) const;
+    unsigned int variant(const Engine&, const Builder&, bool, std::vector<std::pair<const Builder *, bool>>&);
+    void prepareMaterial(const Engine&, const std::string&, Material&, std::vector<std::pair<const Builder *, bool>>&);
+    vk::raii::Pipeline createPipeline(
+      const Engine&,
+      const Builder&,
+      bool depthOnly = false,
+      vk::GraphicsPipelineLibraryFlagsEXT parts = {}
+    ) const;
+    vk::raii::Pipeline createPipeline(
+      const Engine&,
+      ShaderStages&,
+      bool,
+      const PipelineState&,
+      bool,
+      vk::GraphicsPipelineLibraryFlagsEXT
+    ) const;
+    void createFallbacks(const Engine&);
+    void compilePipelines(const Engine&, const std::vector<std::pair<const Builder *, bool>>&);
+    void compileWorker(const Engine&);
+    void createLibraries(const Engine&, const std::vector<std::pair<const Builder *, bool>>&);
+    vk::raii::Pipeline linkPipeline(const Engine&, const Libraries&, bool) const;
+    void optimizePipelines(const Engine&);
+    void createDescriptors(const Engine&, const std::vector<mat4>&, const BoundsArray&);
+    void createParameters(const Engine&, unsigned int, const std::map<const Transform *, std::string>&);
+    void writeParameter(unsigned int, unsigned int, const ParameterValue&);
+    void createCameras(const Engine&);
     void updateSets(const Engine&);
 
   private:
     std::map<std::string, Material> m_materials;
-    std::vector<Builder> m_builders;
+    std::deque<Builder> m_builders;
+    ShaderRegistry m_shaderModules;
+    std::set<std::string> m_transparent;
 
     vk::raii::DescriptorSetLayout m_setLayout = nullptr;
+    vk::raii::DescriptorSetLayout m_cameraSetLayout = nullptr;
+    vk::raii::DescriptorSetLayout m_vertexSetLayout = nullptr;
     vk::raii::PipelineLayout m_layout = nullptr;
+    std::map<PipelineKey, unsigned int> m_variants;
     std::vector<vk::raii::Pipeline> m_pipelines;
+    vk::raii::Pipeline m_fallback = nullptr;
+    vk::raii::Pipeline m_pulledFallback = nullptr;
+
+    std::map<std::pair<bool, vk::PrimitiveTopology>, vk::raii::Pipeline> m_vertexInputLibraries;
+    std::map<std::pair<BlendMode, bool>, vk::raii::Pipeline> m_outputLibraries;
+    std::vector<Libraries> m_libraries;
+
+    bool m_loaded = false;
+    std::vector<std::string> m_pending;
+    std::deque<CompileJob> m_jobs;
+    unsigned int m_nextJob = 0;
+    unsigned int m_workers = 0;
+    std::mutex m_jobMutex;
+    std::vector<std::future<void>> m_compiling;
+    std::future<void> m_optimizer;
+    std::atomic<bool> m_stopping = false;
+    std::mutex m_readyMutex;
+    std::vector<std::pair<unsigned int, vk::raii::Pipeline>> m_ready;
+    std::vector<std::pair<unsigned int, vk::raii::Pipeline>> m_retired;
 
     vk::raii::DescriptorPool m_setPool = nullptr;
     vk::raii::DescriptorSets m_sets = nullptr;
 
+    vk::raii::DescriptorPool m_cameraSetPool = nullptr;
+    vk::raii::DescriptorSets m_cameraSets = nullptr;
+
     vk::raii::DeviceMemory m_transformMemory = nullptr;
     std::vector<vk::raii::Buffer> m_transformBuffers;
     std::vector<unsigned int> m_transformOffsets;
     void * m_transformMap = nullptr;
+
+    vk::raii::DeviceMemory m_boundsMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_boundsBuffers;
+    std::vector<unsigned int> m_boundsOffsets;
+    void * m_boundsMap = nullptr;
+
+    vk::raii::DeviceMemory m_materialMemory = nullptr;
+    vk::raii::Buffer m_materialBuffer = nullptr;
+    void * m_materialMap = nullptr;
+
+    unsigned int m_objectStride = 0;
+    std::vector<unsigned int> m_parameterData;
+    std::vector<std::tuple<const Transform *, unsigned int, ParameterValue>> m_objectValues;
+    std::vector<std::vector<std::pair<unsigned int, unsigned int>>> m_dirtyParameters;
+    vk::raii::DeviceMemory m_parameterMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_parameterBuffers;
+    std::vector<unsigned int> m_parameterOffsets;
+    void * m_parameterMap = nullptr;
+
+    vk::raii::DeviceMemory m_cameraMemory = nullptr;
+    vk::raii::Buffer m_cameraBuffer = nullptr;
+    unsigned int m_cameraStride = 0;
+    void * m_cameraMap = nullptr;
 };
 
 } // namespace ge
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "src/include/bounds.hpp"
+#include "src/include/vertex.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace ge {
+
+struct Meshlet {
+  unsigned int firstIndex = 0;
+  unsigned int indexCount = 0;
+  unsigned int vertexCount = 0;
+  Bounds bounds;
+  vec3 coneAxis = vec3(0.0f);
+  float coneCutoff = 1.0f;
+};
+
+class MeshletBuilder {
+  using Output = std::pair<std::vector<Meshlet>, std::vector<unsigned int>>;
+
+  public:
+    static constexpr unsigned int max_vertices = 64;
+    static constexpr unsigned int max_triangles = 124;
+
+  public:
+    MeshletBuilder() = delete;
+    MeshletBuilder(MeshletBuilder&) = delete;
+    MeshletBuilder(MeshletBuilder&&) = delete;
+
+    ~MeshletBuilder() = default;
+
+    MeshletBuilder& operator = (MeshletBuilder&) = delete;
+    MeshletBuilder& operator = (MeshletBuilder&&) = delete;
+
+    static Output build(
+      const std::vector<Vertex>&,
+      const std::vector<unsigned int>&,
+      unsigned int maxVertices = max_vertices,
+      unsigned int maxTriangles = max_triangles
+    );
+    static Output build(
+      const Vertex *,
+      unsigned int,
+      const unsigned int *,
+      unsigned int,
+      unsigned int maxVertices = max_vertices,
+      unsigned int maxTriangles = max_triangles
+    );
+
+  private:
+    static void finish(const Vertex *, const unsigned int *, Meshlet&);
+};
+
+} // namespace ge
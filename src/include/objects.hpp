@@ -1,13 +1,21 @@
 #pragma once
 
+#include "src/include/bounds.hpp"
+#include "src/include/culling.hpp"
+#include "src/include/meshlets.hpp"
+#include "src/include/occlusion.hpp"
+#include "src/include/optimizer.hpp"
 #include "src/include/transform.hpp"
 #include "src/include/vertex.hpp"
+#include "src/include/workers.hpp"
 
 #include <vulkan/vulkan_raii.hpp>
 #include <vulkan/vulkan_beta.h>
 
 #include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace ge {
@@ -17,14 +25,25 @@ using transform = std::shared_ptr<Transform>;
 class Engine;
 
 class ObjectManager {
+  friend class ImpostorManager;
+  friend class Renderer;
+
   using Output = std::tuple<
     const vk::raii::Buffer&,
     const vk::raii::Buffer&,
     const vk::raii::Buffer&,
+    const vk::raii::DescriptorSet&,
+    const vk::IndexType,
     const unsigned int,
+    const unsigned int&,
     const unsigned int&
   >;
 
+  using Upload = std::pair<
+    vk::raii::DeviceMemory,
+    std::vector<vk::raii::Buffer>
+  >;
+
   private:
     struct IndirectCommand {
       unsigned int indexCount = 0;
@@ -34,13 +53,30 @@ class ObjectManager {
       unsigned int firstInstance = 0;
     };
 
+    struct LodRange {
+      unsigned int firstIndex = 0;
+      unsigned int indexCount = 0;
+    };
+
     struct ObjectData {
       std::vector<Vertex> vertices;
       std::vector<unsigned int> indices;
+      vk::IndexType indexType = vk::IndexType::eUint32;
       unsigned int bufferIndex = 0;
+      unsigned int batchIndex = 0;
       std::vector<IndirectCommand> commands;
+      std::vector<std::vector<LodRange>> lods;
+      std::vector<std::vector<Meshlet>> meshlets;
+      std::vector<Bounds> bounds;
       std::vector<std::shared_ptr<Transform>> transforms;
       unsigned int transformIndex = 0;
+      std::vector<std::vector<std::pair<unsigned int, unsigned int>>> dirtyRanges;
+    };
+
+    struct DynamicRange {
+      std::string material;
+      unsigned int offset = 0;
+      unsigned int count = 0;
     };
 
   public:
@@ -53,23 +89,79 @@ class ObjectManager {
     ObjectManager& operator=(ObjectManager&) = delete;
     ObjectManager& operator=(ObjectManager&&) = delete;
 
-    const Output operator[](std::string) const;
+    const Output staticObjects(std::string, unsigned int) const;
+    const Output dynamicObjects(std::string, unsigned int) const;
 
     bool hasObjects(std::string) const;
+    bool hasDynamicObjects(std::string) const;
     unsigned int commandSize() const;
     const std::vector<mat4>& transforms() const;
+    const BoundsArray& bounds() const;
+    Bounds bounds(const transform&) const;
+    unsigned int batchCount() const;
+    const std::vector<CullData>& cullData() const;
+    const unsigned int& cullVersion() const;
+    const std::vector<ClusterData>& clusterData() const;
+    std::pair<unsigned int, unsigned int> clusters(unsigned int) const;
+    const vk::raii::Buffer& indirectBuffer(unsigned int) const;
+    std::vector<Occluder> occluders() const;
+    const std::vector<std::string>& drawOrder() const;
+    const std::map<const Transform *, std::string>& materials() const;
+    const std::string& material(const transform&) const;
+    OptimizationReport optimization(const transform&) const;
 
     transform add(const std::string&, const std::string&, const Transform&);
+    transform addDynamic(const std::string&, const std::string&, const Transform&);
     void loadTransforms();
-    void load(const Engine&);
+    void load(const Engine&, WorkerPool&);
+    void loadVertexSets(const Engine&, const vk::raii::DescriptorSetLayout&);
     void batch(unsigned int, const std::tuple<vec3, vec3, vec3>&);
+    void batchVertices(const transform&, unsigned int, const std::vector<Vertex>&);
     void updateTransforms();
+    void updateVertices(unsigned int);
     void updateTimes(double);
+    void setOccluder(const transform&, bool);
+    void cull(unsigned int, const Frustum&, WorkerPool&, const OcclusionBuffer * occlusion = nullptr);
+    void selectLods(unsigned int, const mat4&, float);
+    void restoreOrder(unsigned int);
+    void sortBatches(unsigned int, const mat4&, const std::set<std::string>&);
+
+  private:
+    void loadMeshlets(WorkerPool&);
+    void loadLods(WorkerPool&);
+    void loadStatic(const Engine&);
+    void loadDynamic(const Engine&);
+    void loadCommands(const Engine&);
+    static std::vector<char> packIndices(ObjectData&);
+    Upload upload(const Engine&, const std::vector<std::pair<const void *, unsigned int>>&, vk::BufferUsageFlags) const;
 
   private:
     std::map<std::string, ObjectData> m_objects;
+    std::map<std::string, ObjectData> m_dynamicObjects;
+    std::map<const Transform *, DynamicRange> m_dynamicRanges;
+    std::map<const Transform *, std::string> m_objectMaterials;
+    std::map<const Transform *, OptimizationReport> m_reports;
+    std::set<const Transform *> m_occluders;
+    unsigned int m_bufferCount = 0;
+    VertexFormat m_vertexFormat = StandardVertices;
+    unsigned int m_lodLevels = 1;
+    float m_lodScreenSize = 0.25f;
+    std::vector<std::vector<LodRange>> m_lods;
     std::map<unsigned int, std::tuple<vec3, vec3, vec3>> m_updates;
     std::vector<mat4> m_transforms;
+    std::vector<Bounds> m_localBounds;
+    BoundsArray m_worldBounds;
+    std::vector<unsigned char> m_visibility;
+    unsigned int m_batchCount = 0;
+    std::vector<CullData> m_cullData;
+    unsigned int m_cullVersion = 0;
+    bool m_clusterCulling = false;
+    std::vector<ClusterData> m_clusterData;
+    std::vector<unsigned int> m_objectClusters;
+    std::vector<std::pair<unsigned int, unsigned int>> m_batchClusters;
+    bool m_sortObjects = false;
+    std::vector<bool> m_sorted;
+    std::vector<std::string> m_drawOrder;
 
     vk::raii::DeviceMemory m_vertexMemory = nullptr;
     std::vector<vk::raii::Buffer> m_vertexBuffers;
@@ -79,6 +171,19 @@ class ObjectManager {
 
     vk::raii::DeviceMemory m_indirectMemory = nullptr;
     std::vector<vk::raii::Buffer> m_indirectBuffers;
+    std::vector<unsigned int> m_indirectOffsets;
+    void * m_indirectMap = nullptr;
+
+    vk::raii::DeviceMemory m_dynamicMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_dynamicBuffers;
+    std::vector<unsigned int> m_dynamicOffsets;
+    void * m_dynamicMap = nullptr;
+
+    vk::raii::DescriptorPool m_vertexSetPool = nullptr;
+    vk::raii::DescriptorSets m_vertexSets = nullptr;
+
+    vk::raii::DeviceMemory m_dynamicIndexMemory = nullptr;
+    std::vector<vk::raii::Buffer> m_dynamicIndexBuffers;
 };
 
 } // namespace ge
\ No newline at end of file
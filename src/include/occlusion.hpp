@@ -0,0 +1,65 @@
+#pragma once
+
+#include "src/include/bounds.hpp"
+#include "src/include/linalg.hpp"
+#include "src/include/vertex.hpp"
+#include "src/include/workers.hpp"
+
+#include <vector>
+
+namespace ge {
+
+struct Occluder {
+  mat4 transform = mat4::identity();
+  const Vertex * vertices = nullptr;
+  const unsigned int * indices = nullptr;
+  unsigned int indexCount = 0;
+};
+
+class OcclusionBuffer {
+  private:
+    struct Triangle {
+      int minX = 0;
+      int maxX = 0;
+      int minY = 0;
+      int maxY = 0;
+      float edges[3][3] = {};
+      float depth[3] = {};
+    };
+
+  public:
+    OcclusionBuffer() = default;
+    OcclusionBuffer(const OcclusionBuffer&) = default;
+    OcclusionBuffer(OcclusionBuffer&&) = default;
+    OcclusionBuffer(unsigned int, unsigned int);
+
+    ~OcclusionBuffer() = default;
+
+    OcclusionBuffer& operator=(const OcclusionBuffer&) = default;
+    OcclusionBuffer& operator=(OcclusionBuffer&&) = default;
+
+    unsigned int width() const;
+    unsigned int height() const;
+    float depth(unsigned int, unsigned int) const;
+
+    void resize(unsigned int, unsigned int);
+    void render(const mat4&, const std::vector<Occluder>&, WorkerPool&);
+    bool visible(const Bounds&) const;
+
+  private:
+    unsigned int index(unsigned int, unsigned int) const;
+    void setup(const Occluder&, std::vector<Triangle>&) const;
+    void addTriangle(const vec4&, const vec4&, const vec4&, std::vector<Triangle>&) const;
+    void rasterize(const std::vector<Triangle>&, unsigned int, unsigned int);
+
+  private:
+    unsigned int m_width = 0;
+    unsigned int m_height = 0;
+    unsigned int m_tilesX = 0;
+    unsigned int m_tilesY = 0;
+    mat4 m_viewProjection = mat4::identity();
+    std::vector<float> m_depth;
+    std::vector<float> m_tileDepth;
+};
+
+} // namespace ge
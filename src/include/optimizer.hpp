@@ -0,0 +1,45 @@
+#pragma once
+
+#include "src/include/vertex.hpp"
+
+#include <vector>
+
+namespace ge {
+
+struct OptimizationReport {
+  float acmrBefore = 0.0f;
+  float acmrAfter = 0.0f;
+};
+
+class MeshOptimizer {
+  using Output = std::vector<unsigned int>;
+
+  public:
+    static constexpr unsigned int cache_size = 16;
+
+  public:
+    MeshOptimizer() = delete;
+    MeshOptimizer(MeshOptimizer&) = delete;
+    MeshOptimizer(MeshOptimizer&&) = delete;
+
+    ~MeshOptimizer() = default;
+
+    MeshOptimizer& operator = (MeshOptimizer&) = delete;
+    MeshOptimizer& operator = (MeshOptimizer&&) = delete;
+
+    static float acmr(const std::vector<unsigned int>&, unsigned int, unsigned int cacheSize = cache_size);
+    static Output optimizeVertexCache(const std::vector<unsigned int>&, unsigned int, unsigned int cacheSize = cache_size);
+    static Output optimizeOverdraw(
+      const std::vector<Vertex>&,
+      const std::vector<unsigned int>&,
+      float threshold = 1.05f,
+      unsigned int cacheSize = cache_size
+    );
+    static void optimizeVertexFetch(std::vector<Vertex>&, std::vector<unsigned int>&);
+    static OptimizationReport optimize(std::vector<Vertex>&, std::vector<unsigned int>&, bool reorderVertices = true);
+
+  private:
+    static std::vector<unsigned int> clusters(const std::vector<unsigned int>&, unsigned int, float, unsigned int);
+};
+
+} // namespace ge
@@ -24,6 +24,26 @@ class ObjParser {
     static Output parse(std::string);
 };
 
+class MappedFile {
+  public:
+    MappedFile(const std::string&);
+    MappedFile(MappedFile&) = delete;
+    MappedFile(MappedFile&&);
+
+    ~MappedFile();
+
+    MappedFile& operator = (MappedFile&) = delete;
+    MappedFile& operator = (MappedFile&&) = delete;
+
+    const char * data() const;
+    unsigned int size() const;
+
+  private:
+    int m_file = -1;
+    void * m_data = nullptr;
+    unsigned int m_size = 0;
+};
+
 class SPVParser {
   using Output = std::vector<char>;
 
@@ -38,6 +58,8 @@ class SPVParser {
     SPVParser& operator = (SPVParser&&) = delete;
 
     static Output parse(std::string);
+    static MappedFile map(std::string);
+    static std::vector<unsigned int> invariantPosition(const char *, unsigned int);
 };
 
 } // namespace ge
\ No newline at end of file
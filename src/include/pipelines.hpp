@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <array>
+#include <atomic>
+#include <string>
+
+namespace ge {
+
+class Engine;
+
+struct PipelineCacheStatistics {
+  bool loaded = false;
+  unsigned int pipelines = 0;
+  unsigned int hits = 0;
+};
+
+class PipelineCache {
+  private:
+    struct Header {
+      unsigned int magic = 0x43504547;
+      unsigned int version = 1;
+      unsigned int vendorID = 0;
+      unsigned int deviceID = 0;
+      unsigned int driverVersion = 0;
+      std::array<unsigned char, VK_UUID_SIZE> deviceUUID = {};
+      std::array<unsigned char, VK_UUID_SIZE> pipelineCacheUUID = {};
+      unsigned long long size = 0;
+
+      bool operator==(const Header&) const = default;
+    };
+
+  public:
+    PipelineCache() = default;
+    PipelineCache(PipelineCache&) = delete;
+    PipelineCache(PipelineCache&&) = delete;
+
+    ~PipelineCache() = default;
+
+    PipelineCache& operator=(PipelineCache&) = delete;
+    PipelineCache& operator=(PipelineCache&&) = delete;
+
+    PipelineCacheStatistics statistics() const;
+
+    void load(const Engine&);
+    void save(const Engine&) const;
+    vk::raii::Pipeline createGraphicsPipeline(const Engine&, vk::GraphicsPipelineCreateInfo) const;
+    vk::raii::Pipeline createComputePipeline(const Engine&, vk::ComputePipelineCreateInfo) const;
+
+  private:
+    Header header(const Engine&) const;
+    void record(const vk::PipelineCreationFeedback&) const;
+
+  private:
+    std::string m_path;
+    bool m_loaded = false;
+    mutable std::atomic<unsigned int> m_pipelines = 0;
+    mutable std::atomic<unsigned int> m_hits = 0;
+
+    vk::raii::PipelineCache m_cache = nullptr;
+};
+
+} // namespace ge
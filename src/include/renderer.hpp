@@ -1,6 +1,7 @@
 #pragma once
 
 #include "src/include/materials.hpp"
+#include "src/include/objects.hpp"
 
 #include <vulkan/vulkan_raii.hpp>
 #include <vulkan/vulkan_beta.h>
@@ -12,6 +13,13 @@ namespace ge {
 class Engine;
 
 class Renderer {
+  private:
+    enum Pass {
+      DepthPass,
+      OpaquePass,
+      TransparentPass
+    };
+
   public:
     Renderer() = default;
     Renderer(Renderer&) = delete;
@@ -23,8 +31,14 @@ class Renderer {
     Renderer& operator = (Renderer&&) = delete;
 
     const unsigned int& frameIndex() const;
+    const mat4& view() const;
+    const mat4& projection() const;
+    mat4 viewProjection() const;
+    vec3 cameraPosition() const;
+    const vk::raii::ImageView& depthView() const;
 
     void initialize(Engine&);
+    void waitForFrame(const Engine&) const;
     void render(const Engine&);
 
   private:
@@ -33,11 +47,16 @@ class Renderer {
     std::pair<unsigned int, vk::SurfaceTransformFlagBitsKHR> checkExtent(Engine&) const;
 
     void createSwapchain(const Engine&, const unsigned int&, const vk::SurfaceTransformFlagBitsKHR&);
+    void createOffscreenImages(const Engine&);
     void createViews(const Engine&);
     void createSyncObjects(const Engine&);
     void transitionImages(const unsigned int&);
-    void preDraw(const Engine&, const unsigned int&);
-    void draw(const Engine&);
+    void finishImage(const unsigned int&);
+    void preDraw(const Engine&, const unsigned int&, vk::AttachmentLoadOp loadOp = vk::AttachmentLoadOp::eClear);
+    void bindMaterialSets(const Engine&);
+    void draw(const Engine&, unsigned int phase = 0);
+    void drawMaterials(const Engine&, unsigned int, Pass);
+    void drawObjects(const Engine&, EngineData&, const ObjectManager::Output&, bool, unsigned int);
     void endRendering();
 
   private:
@@ -46,6 +65,8 @@ class Renderer {
     mat4 m_projection = mat4::identity();
 
     vk::raii::SwapchainKHR m_swapchain = nullptr;
+    std::vector<vk::raii::DeviceMemory> m_offscreenMemory;
+    std::vector<vk::raii::Image> m_offscreenImages;
     std::vector<vk::Image> m_images;
     std::vector<vk::raii::ImageView> m_views;
 
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace ge {
+
+class Engine;
+
+class ShaderRegistry {
+  using Key = std::tuple<std::string, unsigned long long, bool>;
+
+  public:
+    ShaderRegistry() = default;
+    ShaderRegistry(ShaderRegistry&) = delete;
+    ShaderRegistry(ShaderRegistry&&) = delete;
+
+    ~ShaderRegistry() = default;
+
+    ShaderRegistry& operator=(ShaderRegistry&) = delete;
+    ShaderRegistry& operator=(ShaderRegistry&&) = delete;
+
+    unsigned int size() const;
+    const vk::raii::ShaderModule& module(const Engine&, const std::string&, bool invariant = false) const;
+
+    static unsigned long long hash(const char *, unsigned int);
+
+  private:
+    mutable std::mutex m_mutex;
+    mutable std::map<Key, vk::raii::ShaderModule> m_modules;
+};
+
+} // namespace ge
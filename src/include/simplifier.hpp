@@ -0,0 +1,45 @@
+#pragma once
+
+#include "src/include/vertex.hpp"
+
+#include <vector>
+
+namespace ge {
+
+class MeshSimplifier {
+  using Output = std::vector<unsigned int>;
+  using LodOutput = std::vector<std::vector<unsigned int>>;
+
+  private:
+    struct Quadric {
+      double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+      double b2 = 0.0, bc = 0.0, bd = 0.0;
+      double c2 = 0.0, cd = 0.0;
+      double d2 = 0.0;
+
+      Quadric& operator+=(const Quadric&);
+      Quadric operator+(const Quadric&) const;
+      double error(const vec3&) const;
+    };
+
+  public:
+    MeshSimplifier() = delete;
+    MeshSimplifier(MeshSimplifier&) = delete;
+    MeshSimplifier(MeshSimplifier&&) = delete;
+
+    ~MeshSimplifier() = default;
+
+    MeshSimplifier& operator = (MeshSimplifier&) = delete;
+    MeshSimplifier& operator = (MeshSimplifier&&) = delete;
+
+    static Output simplify(const std::vector<Vertex>&, const std::vector<unsigned int>&, unsigned int, float);
+    static Output simplify(const Vertex *, unsigned int, const unsigned int *, unsigned int, unsigned int, float);
+
+    static LodOutput lods(const std::vector<Vertex>&, const std::vector<unsigned int>&, unsigned int);
+    static LodOutput lods(const Vertex *, unsigned int, const unsigned int *, unsigned int, unsigned int);
+
+  private:
+    static Quadric plane(const vec3&, const vec3&, const vec3&);
+};
+
+} // namespace ge
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ge {
+
+class Engine;
+
+enum SamplerType {
+  LinearRepeat,
+  LinearClamp,
+  NearestRepeat,
+  NearestClamp
+};
+
+class TextureManager {
+  private:
+    struct Texture {
+      unsigned int width = 0;
+      unsigned int height = 0;
+      std::vector<unsigned char> pixels;
+
+      vk::raii::DeviceMemory memory = nullptr;
+      vk::raii::Image image = nullptr;
+      vk::raii::ImageView view = nullptr;
+    };
+
+  public:
+    static constexpr unsigned int sampler_count = 4;
+
+    TextureManager() = default;
+    TextureManager(TextureManager&) = delete;
+    TextureManager(TextureManager&&) = delete;
+
+    ~TextureManager() = default;
+
+    TextureManager& operator=(TextureManager&) = delete;
+    TextureManager& operator=(TextureManager&&) = delete;
+
+    bool exists(const std::string&) const;
+    bool loaded() const;
+    unsigned int index(const std::string&) const;
+    unsigned int count() const;
+    const vk::raii::ImageView& view(unsigned int) const;
+    const vk::raii::Sampler& sampler(SamplerType) const;
+
+    unsigned int add(const Engine&, const std::string&, unsigned int, unsigned int, const std::vector<unsigned char>&);
+    void load(const Engine&);
+
+  private:
+    void createSamplers(const Engine&);
+    void upload(const Engine&, unsigned int, unsigned int);
+
+  private:
+    bool m_loaded = false;
+    std::map<std::string, unsigned int> m_indices;
+    std::vector<Texture> m_textures;
+    std::vector<vk::raii::Sampler> m_samplers;
+};
+
+} // namespace ge
@@ -4,10 +4,12 @@
 
 namespace ge {
 
+class MaterialManager;
 class ObjectManager;
 
 class Transform {
   friend class Engine;
+  friend class MaterialManager;
   friend class ObjectManager;
 
   public:
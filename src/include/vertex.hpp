@@ -5,8 +5,18 @@
 #include <vulkan/vulkan_raii.hpp>
 #include <vulkan/vulkan_beta.h>
 
+#include <array>
+#include <vector>
+
 namespace ge {
 
+// CompactVertices changes location 2 from a vec3 normal to an octahedral vec2
+// (eR16G16Snorm), decode it with octDecode from src/shaders/octahedral.glsl
+enum VertexFormat {
+  StandardVertices,
+  CompactVertices
+};
+
 class Vertex {
   public:
     Vertex() = default;
@@ -19,8 +29,11 @@ class Vertex {
     Vertex& operator = (const Vertex&) = default;
     Vertex& operator = (Vertex&&) = default;
 
-    static vk::VertexInputBindingDescription binding();
-    static std::array<vk::VertexInputAttributeDescription, 3> attributes();
+    static unsigned int size(VertexFormat format = StandardVertices);
+    static vk::VertexInputBindingDescription binding(VertexFormat format = StandardVertices);
+    static std::array<vk::VertexInputAttributeDescription, 3> attributes(VertexFormat format = StandardVertices);
+    static void pack(VertexFormat, const Vertex *, unsigned int, void *);
+    static std::vector<char> pack(VertexFormat, const std::vector<Vertex>&);
 
     bool operator == (const Vertex&) const;
 
@@ -30,4 +43,18 @@ class Vertex {
     vec3 m_normal = vec3(0.0f);
 };
 
-} // namespace ge
\ No newline at end of file
+struct CompactVertex {
+  float position[3] = { 0.0f, 0.0f, 0.0f };
+  unsigned short uv[2] = { 0, 0 };
+  short normal[2] = { 0, 0 };
+
+  CompactVertex() = default;
+  explicit CompactVertex(const Vertex&);
+
+  static unsigned short half(float);
+  static float fromHalf(unsigned short);
+  static std::array<short, 2> octahedral(const vec3&);
+  static vec3 fromOctahedral(const std::array<short, 2>&);
+};
+
+} // namespace ge
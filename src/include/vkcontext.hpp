@@ -38,6 +38,8 @@ class VulkanContext {
     const vk::raii::PhysicalDevice& gpu() const;
     const vk::raii::Device& device() const;
     const QueueFamily& queueFamily(QueueFamilyType) const;
+    bool pipelineLibraries() const;
+    bool headlessSurface() const;
 
     void initialize(const Engine&);
 
@@ -52,6 +54,8 @@ class VulkanContext {
     vk::raii::PhysicalDevice m_gpu = nullptr;
     vk::raii::Device m_device = nullptr;
     QueueFamilies m_queueFamilies;
+    bool m_pipelineLibraries = false;
+    bool m_headlessSurface = false;
 };
 
 } // namespace ge
\ No newline at end of file
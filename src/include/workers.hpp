@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ge {
+
+class WorkerPool {
+  using Task = std::function<void(unsigned int)>;
+
+  public:
+    WorkerPool();
+    WorkerPool(unsigned int);
+    WorkerPool(WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+
+    ~WorkerPool();
+
+    WorkerPool& operator=(WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    unsigned int size() const;
+    void run(unsigned int, const Task&);
+
+  private:
+    void work();
+    void execute();
+
+  private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_runMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const Task * m_task = nullptr;
+    unsigned int m_count = 0;
+    unsigned int m_next = 0;
+    unsigned int m_finished = 0;
+    std::exception_ptr m_error;
+    bool m_stopping = false;
+};
+
+} // namespace ge
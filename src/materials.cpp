@@ -1,15 +1,196 @@
 #include "src/include/allocator.hpp"
 #include "src/include/engine.hpp"
 #include "src/include/materials.hpp"
-#include "src/include/parsers.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <utility>
 
 namespace ge {
 
+static const unsigned int fallbackVertCode[] = {
+#include "fallback.vert.inc"
+};
+
+static const unsigned int fallbackPullCode[] = {
+#include "fallback_pull.vert.inc"
+};
+
+static const unsigned int fallbackFragCode[] = {
+#include "fallback.frag.inc"
+};
+
+// parameter buffer header: material stride, object stride, object offset
+// the offset is relative to the words following the header
+static const unsigned int parameterHeaderSize = 3;
+
+ParameterValue::ParameterValue(float value) : type(FloatParameter) {
+  words[0] = std::bit_cast<unsigned int>(value);
+}
+
+ParameterValue::ParameterValue(int value) : type(IntParameter) {
+  words[0] = std::bit_cast<unsigned int>(value);
+}
+
+ParameterValue::ParameterValue(unsigned int value) : type(UintParameter) {
+  words[0] = value;
+}
+
+ParameterValue::ParameterValue(const vec2& value) : type(Vec2Parameter) {
+  for (unsigned int i = 0; i < 2; ++i)
+    words[i] = std::bit_cast<unsigned int>(value[i]);
+}
+
+ParameterValue::ParameterValue(const vec3& value) : type(Vec3Parameter) {
+  for (unsigned int i = 0; i < 3; ++i)
+    words[i] = std::bit_cast<unsigned int>(value[i]);
+}
+
+ParameterValue::ParameterValue(const vec4& value) : type(Vec4Parameter) {
+  for (unsigned int i = 0; i < 4; ++i)
+    words[i] = std::bit_cast<unsigned int>(value[i]);
+}
+
+unsigned int ParameterValue::size() const {
+  switch (type) {
+    case Vec2Parameter: return 2;
+    case Vec3Parameter: return 3;
+    case Vec4Parameter: return 4;
+    default:            return 1;
+  }
+}
+
+static void collect(std::future<void>& job) {
+  try {
+    job.get();
+  }
+  catch (const std::exception& e) {
+    throw std::runtime_error(std::string("groot-engine: background pipeline compile failed: ") + e.what());
+  }
+}
+
+CameraData CameraData::compute(const mat4& view, const mat4& projection) {
+  CameraData out{
+    .view           = view,
+    .projection     = projection,
+    .viewProjection = projection * view
+  };
+
+  out.inverseView = view.inverse().value_or(mat4::identity());
+  out.inverseProjection = projection.inverse().value_or(mat4::identity());
+  out.inverseViewProjection = out.viewProjection.inverse().value_or(mat4::identity());
+  out.position = out.inverseView * vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+  return out;
+}
+
 MaterialManager::Builder& MaterialManager::Builder::add_shader(ShaderStage stage, std::string path) {
   m_shaders[static_cast<vk::ShaderStageFlagBits>(stage)] = path;
   return *this;
 }
 
+MaterialManager::Builder& MaterialManager::Builder::set_vertex_pulling(bool pulling) {
+  m_vertexPulling = pulling;
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_blend_mode(BlendMode mode) {
+  m_state.blendMode = mode;
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_topology(vk::PrimitiveTopology topology) {
+  m_state.topology = topology;
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_polygon_mode(vk::PolygonMode mode) {
+  m_state.polygonMode = mode;
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_cull_mode(vk::CullModeFlags mode, vk::FrontFace front) {
+  m_state.cullMode = mode;
+  m_state.frontFace = front;
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_depth_test(bool test, bool write, vk::CompareOp compare) {
+  m_state.depthTest = test;
+  m_state.depthWrite = write;
+  m_state.depthCompare = compare;
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_constant(ShaderStage stage, unsigned int id, bool value) {
+  return set_constant(stage, id, static_cast<unsigned int>(value ? VK_TRUE : VK_FALSE));
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_constant(ShaderStage stage, unsigned int id, int value) {
+  return set_constant(stage, id, std::bit_cast<unsigned int>(value));
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_constant(ShaderStage stage, unsigned int id, unsigned int value) {
+  m_constants[static_cast<vk::ShaderStageFlagBits>(stage)][id] = value;
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_constant(ShaderStage stage, unsigned int id, float value) {
+  return set_constant(stage, id, std::bit_cast<unsigned int>(value));
+}
+
+MaterialManager::Builder& MaterialManager::Builder::add_texture(std::string tag, SamplerType sampler) {
+  if (m_textures.size() == max_textures)
+    throw std::runtime_error("groot-engine: materials can use at most " + std::to_string(max_textures) + " textures");
+
+  m_textures.emplace_back(tag, sampler);
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_parameter(std::string name, const ParameterValue& value) {
+  declare(m_parameters, name, value);
+  return *this;
+}
+
+MaterialManager::Builder& MaterialManager::Builder::set_object_parameter(std::string name, const ParameterValue& value) {
+  declare(m_objectParameters, name, value);
+  return *this;
+}
+
+void MaterialManager::Builder::declare(std::vector<Parameter>& parameters, const std::string& name, const ParameterValue& value) {
+  for (Parameter& parameter : parameters) {
+    if (parameter.name != name) continue;
+
+    if (parameter.value.type != value.type)
+      throw std::runtime_error("groot-engine: parameter '" + name + "' already declared with a different type");
+
+    parameter.value = value;
+    return;
+  }
+
+  unsigned int column = parameters.empty() ? 0 : parameters.back().column + parameters.back().value.size();
+  if (column + value.size() > max_parameters)
+    throw std::runtime_error("groot-engine: parameter blocks can hold at most " + std::to_string(max_parameters) + " components");
+
+  parameters.emplace_back(Parameter{ .name = name, .column = column, .value = value });
+}
+
+const MaterialManager::Builder::Parameter& MaterialManager::Builder::find(
+  const std::vector<Parameter>& parameters,
+  const std::string& name
+) {
+  for (const Parameter& parameter : parameters) {
+    if (parameter.name == name) return parameter;
+  }
+
+  throw std::runtime_error("groot-engine: parameter '" + name + "' does not exist");
+}
+
 MaterialManager::Iterator::Iterator(
   const MaterialManager * manager,
   const std::map<std::string, Material>::const_iterator& iterator
@@ -21,7 +202,7 @@ bool MaterialManager::Iterator::operator!=(const Iterator& rhs) const {
 
 MaterialManager::Iterator::Output MaterialManager::Iterator::operator*() const {
   auto& [tag, material] = *m_iterator;
-  return Output(tag, m_manager->m_pipelines[material.pipeline]);
+  return Output(tag, m_manager->pipeline(tag));
 }
 
 MaterialManager::Iterator& MaterialManager::Iterator::operator++() {
@@ -29,6 +210,14 @@ MaterialManager::Iterator& MaterialManager::Iterator::operator++() {
   return *this;
 }
 
+MaterialManager::~MaterialManager() {
+  m_stopping = true;
+  for (auto& job : m_compiling)
+    job.wait();
+  if (m_optimizer.valid())
+    m_optimizer.wait();
+}
+
 MaterialManager::Iterator MaterialManager::begin() const {
   return Iterator(this, m_materials.begin());
 }
@@ -41,95 +230,607 @@ bool MaterialManager::exists(std::string tag) const {
   return m_materials.contains(tag);
 }
 
+bool MaterialManager::vertexPulling(std::string tag) const {
+  return m_builders[m_materials.at(tag).builder].m_vertexPulling;
+}
+
+unsigned int MaterialManager::index(std::string tag) const {
+  return m_materials.at(tag).index;
+}
+
+unsigned int MaterialManager::pipelineCount() const {
+  return m_pipelines.size();
+}
+
+bool MaterialManager::prepass(std::string tag) const {
+  return m_materials.at(tag).prepass && ready(tag);
+}
+
+bool MaterialManager::ready(std::string tag) const {
+  const Material& material = m_materials.at(tag);
+  if (material.pipeline >= m_pipelines.size() || *m_pipelines[material.pipeline] == nullptr) return false;
+
+  return !material.prepass || *m_pipelines[material.depthPipeline] != nullptr;
+}
+
+const std::set<std::string>& MaterialManager::transparent() const {
+  return m_transparent;
+}
+
+const vk::raii::Pipeline& MaterialManager::pipeline(std::string tag) const {
+  if (!ready(tag))
+    return vertexPulling(tag) ? m_pulledFallback : m_fallback;
+
+  return m_pipelines[m_materials.at(tag).pipeline];
+}
+
+const vk::raii::Pipeline& MaterialManager::depthPipeline(std::string tag) const {
+  return m_pipelines[m_materials.at(tag).depthPipeline];
+}
+
 const vk::raii::PipelineLayout& MaterialManager::layout() const {
   return m_layout;
 }
 
+const vk::raii::DescriptorSetLayout& MaterialManager::cameraSetLayout() const {
+  return m_cameraSetLayout;
+}
+
+const vk::raii::DescriptorSetLayout& MaterialManager::vertexSetLayout() const {
+  return m_vertexSetLayout;
+}
+
 const vk::raii::DescriptorSet& MaterialManager::descriptorSet(unsigned int frameIndex) const {
   return m_sets[frameIndex];
 }
 
+const vk::raii::DescriptorSet& MaterialManager::cameraSet() const {
+  return m_cameraSets[0];
+}
+
+unsigned int MaterialManager::cameraOffset(unsigned int slot) const {
+  return slot * m_cameraStride;
+}
+
+const vk::raii::Buffer& MaterialManager::transformBuffer(unsigned int frameIndex) const {
+  return m_transformBuffers[frameIndex];
+}
+
 void MaterialManager::add(const std::string& tag, const Builder& builder) {
-  m_materials.emplace(tag, Material{ .builder = static_cast<unsigned int>(m_builders.size()) });
+  if (m_materials.size() >= ge_max_descriptors)
+    throw std::runtime_error("groot-engine: material limit of " + std::to_string(ge_max_descriptors) + " reached");
+
+  m_materials.emplace(tag, Material{
+    .builder  = static_cast<unsigned int>(m_builders.size()),
+    .index    = static_cast<unsigned int>(m_materials.size())
+  });
   m_builders.emplace_back(builder);
+
+  if (m_loaded)
+    m_pending.emplace_back(tag);
 }
 
 void MaterialManager::add(const std::string& tag, Builder&& builder) {
-  m_materials.emplace(tag, Material{ .builder = static_cast<unsigned int>(m_builders.size()) });
+  if (m_materials.size() >= ge_max_descriptors)
+    throw std::runtime_error("groot-engine: material limit of " + std::to_string(ge_max_descriptors) + " reached");
+
+  m_materials.emplace(tag, Material{
+    .builder  = static_cast<unsigned int>(m_builders.size()),
+    .index    = static_cast<unsigned int>(m_materials.size())
+  });
   m_builders.emplace_back(std::move(builder));
+
+  if (m_loaded)
+    m_pending.emplace_back(tag);
 }
 
-void MaterialManager::load(const Engine& engine, const std::vector<mat4>& transforms) {
+void MaterialManager::load(
+  const Engine& engine,
+  const std::vector<mat4>& transforms,
+  const BoundsArray& bounds,
+  const std::map<const Transform *, std::string>& objects
+) {
   createLayout(engine, transforms.size());
+  createDescriptors(engine, transforms, bounds);
+  createParameters(engine, transforms.size(), objects);
+  createFallbacks(engine);
 
+  std::vector<std::pair<const Builder *, bool>> jobs;
+  unsigned int materialIndex = 0;
+  m_pipelines.clear();
   for (auto& [tag, material] : m_materials) {
-    material.pipeline = m_pipelines.size();
-    createPipeline(engine, m_builders[material.builder]);
+    material.index = materialIndex++;
+    prepareMaterial(engine, tag, material, jobs);
+  }
+
+  if (engine.m_settings.async_materials) {
+    compilePipelines(engine, jobs);
+    jobs.clear();
   }
 
-  createDescriptors(engine, transforms);
+  bool libraries = engine.m_context.pipelineLibraries() && !jobs.empty();
+  if (libraries)
+    createLibraries(engine, jobs);
+
+  std::atomic<unsigned int> next = 0;
+  auto compile = [this, &engine, &jobs, &next, libraries]() {
+    for (unsigned int i = next++; i < jobs.size(); i = next++) {
+      const auto& [builder, depthOnly] = jobs[i];
+
+      if (!libraries) {
+        m_pipelines[i] = createPipeline(engine, *builder, depthOnly);
+        continue;
+      }
 
-  auto [tmp_setPool, tmp_sets] = Allocator::descriptorPool(engine, m_setLayout);
+      Libraries& library = m_libraries[i];
+      library.preRasterization = createPipeline(engine, *builder, depthOnly,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders
+      );
+      library.fragmentShader = createPipeline(engine, *builder, depthOnly,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader
+      );
+
+      m_pipelines[i] = linkPipeline(engine, library, false);
+    }
+  };
+
+  unsigned int workers = std::min(std::max(std::thread::hardware_concurrency(), 1u), static_cast<unsigned int>(jobs.size()));
+  std::vector<std::future<void>> threads;
+  for (unsigned int i = 1; i < workers; ++i)
+    threads.emplace_back(std::async(std::launch::async, compile));
+
+  compile();
+
+  for (auto& thread : threads)
+    thread.get();
+
+  if (libraries)
+    optimizePipelines(engine);
+
+  unsigned int count = engine.m_settings.buffer_mode;
+  auto [tmp_setPool, tmp_sets] = Allocator::descriptorPool(engine, m_setLayout, count, {
+      vk::DescriptorPoolSize{
+        .type             = vk::DescriptorType::eStorageBuffer,
+        .descriptorCount  = count * 4
+      },
+      vk::DescriptorPoolSize{
+        .type             = vk::DescriptorType::eSampler,
+        .descriptorCount  = count * TextureManager::sampler_count
+      },
+      vk::DescriptorPoolSize{
+        .type             = vk::DescriptorType::eSampledImage,
+        .descriptorCount  = count * ge_max_descriptors
+      }
+    },
+    vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+    ge_max_descriptors
+  );
   m_setPool = std::move(tmp_setPool);
   m_sets = std::move(tmp_sets);
 
+  auto [tmp_cameraPool, tmp_cameraSets] = Allocator::descriptorPool(engine, m_cameraSetLayout, 1, {
+    vk::DescriptorPoolSize{
+      .type             = vk::DescriptorType::eUniformBufferDynamic,
+      .descriptorCount  = 1
+    }
+  });
+  m_cameraSetPool = std::move(tmp_cameraPool);
+  m_cameraSets = std::move(tmp_cameraSets);
+
+  for (unsigned int i = 0; i < count; ++i) {
+    memcpy(reinterpret_cast<char *>(m_parameterMap) + m_parameterOffsets[i], m_parameterData.data(), sizeof(unsigned int) * m_parameterData.size());
+    m_dirtyParameters[i].clear();
+  }
+
+  createCameras(engine);
   updateSets(engine);
+  m_loaded = true;
 }
 
 void MaterialManager::updateTransforms(const unsigned int& frameIndex, const std::vector<mat4>& transforms) {
   memcpy(reinterpret_cast<char *>(m_transformMap) + m_transformOffsets[frameIndex], transforms.data(), sizeof(mat4) * transforms.size());
 }
 
-MaterialManager::ShaderStages MaterialManager::getShaderStages(const Engine& engine, const Builder& builder) const {
-  std::vector<vk::raii::ShaderModule> modules;
-  std::vector<vk::PipelineShaderStageCreateInfo> infos;
+void MaterialManager::updateBounds(const unsigned int& frameIndex, const BoundsArray& bounds) {
+  memcpy(reinterpret_cast<char *>(m_boundsMap) + m_boundsOffsets[frameIndex], bounds.data(), bounds.bytes());
+}
 
-  for (auto [stage, path] : builder.m_shaders) {
-    std::vector<char> code = SPVParser::parse(path);
+void MaterialManager::updateParameters(const unsigned int& frameIndex) {
+  auto& ranges = m_dirtyParameters[frameIndex];
+  if (ranges.empty()) return;
+
+  std::sort(ranges.begin(), ranges.end());
+
+  char * dst = reinterpret_cast<char *>(m_parameterMap) + m_parameterOffsets[frameIndex];
+  auto flush = [this, dst](unsigned int begin, unsigned int end) {
+    memcpy(dst + begin * sizeof(unsigned int), m_parameterData.data() + begin, (end - begin) * sizeof(unsigned int));
+  };
+
+  auto [begin, end] = ranges.front();
+  for (const auto& [rangeBegin, rangeEnd] : ranges) {
+    if (rangeBegin > end) {
+      flush(begin, end);
+      begin = rangeBegin;
+    }
+    end = std::max(end, rangeEnd);
+  }
+  flush(begin, end);
+
+  ranges.clear();
+}
+
+void MaterialManager::setParameter(const std::string& tag, const std::string& name, const ParameterValue& value) {
+  const Material& material = m_materials.at(tag);
+  Builder& builder = m_builders[material.builder];
 
-    modules.emplace_back(engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
-      .codeSize = static_cast<unsigned int>(code.size()),
-      .pCode    = reinterpret_cast<unsigned int *>(code.data())
-    }));
+  const Builder::Parameter& parameter = Builder::find(builder.m_parameters, name);
+  if (parameter.value.type != value.type)
+    throw std::runtime_error("groot-engine: parameter '" + name + "' of material '" + tag + "' has a different type");
 
-    infos.emplace_back(vk::PipelineShaderStageCreateInfo{
+  if (m_loaded && material.index >= ge_max_descriptors)
+    throw std::runtime_error("groot-engine: material limit of " + std::to_string(ge_max_descriptors) + " reached");
+
+  Builder::declare(builder.m_parameters, name, value);
+
+  if (m_loaded)
+    writeParameter(materialParameter(parameter.column, material.index), ge_max_descriptors, value);
+}
+
+void MaterialManager::setParameter(
+  const std::string& tag,
+  const Transform * object,
+  const std::string& name,
+  const ParameterValue& value
+) {
+  const Builder& builder = m_builders[m_materials.at(tag).builder];
+
+  const Builder::Parameter& parameter = Builder::find(builder.m_objectParameters, name);
+  if (parameter.value.type != value.type)
+    throw std::runtime_error("groot-engine: parameter '" + name + "' of material '" + tag + "' has a different type");
+
+  if (!m_loaded) {
+    m_objectValues.emplace_back(object, parameter.column, value);
+    return;
+  }
+
+  writeParameter(objectParameter(parameter.column, object->m_index, m_objectStride), m_objectStride, value);
+}
+
+void MaterialManager::updateCamera(unsigned int slot, const CameraData& camera) {
+  memcpy(reinterpret_cast<char *>(m_cameraMap) + cameraOffset(slot), &camera, sizeof(CameraData));
+}
+
+void MaterialManager::updatePipelines(const Engine& engine) {
+  for (auto& [frames, pipeline] : m_retired)
+    --frames;
+  std::erase_if(m_retired, [](const auto& retired) { return retired.first == 0; });
+
+  if (!m_pending.empty()) {
+    std::vector<std::string> pending = std::exchange(m_pending, {});
+    std::vector<std::pair<const Builder *, bool>> jobs;
+    for (const std::string& tag : pending)
+      prepareMaterial(engine, tag, m_materials.at(tag), jobs);
+
+    compilePipelines(engine, jobs);
+  }
+
+  for (auto it = m_compiling.begin(); it != m_compiling.end();) {
+    if (it->wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      ++it;
+      continue;
+    }
+
+    std::future<void> job = std::move(*it);
+    it = m_compiling.erase(it);
+    collect(job);
+  }
+
+  if (m_optimizer.valid() && m_optimizer.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    collect(m_optimizer);
+
+  std::lock_guard lock(m_readyMutex);
+  for (auto& [index, pipeline] : m_ready) {
+    if (*m_pipelines[index] != nullptr)
+      m_retired.emplace_back(engine.m_settings.buffer_mode, std::move(m_pipelines[index]));
+    m_pipelines[index] = std::move(pipeline);
+  }
+  m_ready.clear();
+}
+
+void MaterialManager::waitPipelines(const Engine& engine) {
+  for (auto& job : m_compiling)
+    job.wait();
+
+  updatePipelines(engine);
+}
+
+void MaterialManager::finishPipelines() {
+  for (auto& job : m_compiling)
+    job.wait();
+  if (m_optimizer.valid())
+    m_optimizer.wait();
+}
+
+MaterialManager::ShaderStages MaterialManager::getShaderStages(const Engine& engine, const Builder& builder) const {
+  ShaderStages stages;
+  stages.specializations.reserve(builder.m_shaders.size());
+
+  bool invariant = usesPrepass(engine, builder);
+  for (auto [stage, path] : builder.m_shaders) {
+    stages.infos.emplace_back(vk::PipelineShaderStageCreateInfo{
       .stage  = stage,
-      .module = modules.back(),
+      .module = m_shaderModules.module(engine, path, invariant && stage == vk::ShaderStageFlagBits::eVertex),
       .pName  = "main"
     });
+
+    if (!builder.m_constants.contains(stage)) continue;
+
+    std::vector<vk::SpecializationMapEntry>& entries = stages.entries.emplace_back();
+    std::vector<unsigned int>& data = stages.data.emplace_back();
+    for (auto [id, value] : builder.m_constants.at(stage)) {
+      entries.emplace_back(vk::SpecializationMapEntry{
+        .constantID = id,
+        .offset     = static_cast<unsigned int>(data.size() * sizeof(unsigned int)),
+        .size       = sizeof(unsigned int)
+      });
+      data.emplace_back(value);
+    }
+
+    stages.infos.back().pSpecializationInfo = &stages.specializations.emplace_back(vk::SpecializationInfo{
+      .mapEntryCount  = static_cast<unsigned int>(entries.size()),
+      .pMapEntries    = entries.data(),
+      .dataSize       = data.size() * sizeof(unsigned int),
+      .pData          = data.data()
+    });
   }
 
-  return { std::move(modules), std::move(infos) };
+  return stages;
+}
+
+bool MaterialManager::usesPrepass(const Engine& engine, const Builder& builder) const {
+  const PipelineState& state = builder.m_state;
+  return engine.m_settings.depth_prepass &&
+         state.blendMode == OpaqueBlending &&
+         state.depthTest &&
+         state.depthWrite;
+}
+
+PipelineState MaterialManager::pipelineState(const Engine& engine, const Builder& builder, bool depthOnly) const {
+  PipelineState state = builder.m_state;
+
+  if (state.blendMode != OpaqueBlending) {
+    state.depthWrite = false;
+  }
+  else if (!depthOnly && usesPrepass(engine, builder)) {
+    state.depthWrite = false;
+    state.depthCompare = vk::CompareOp::eEqual;
+  }
+
+  return state;
+}
+
+MaterialManager::PipelineKey MaterialManager::pipelineKey(const Engine& engine, const Builder& builder, bool depthOnly) const {
+  std::string key;
+  auto append = [&key](unsigned int value) {
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  for (const auto& [stage, path] : builder.m_shaders) {
+    if (depthOnly && stage == vk::ShaderStageFlagBits::eFragment) continue;
+
+    append(static_cast<unsigned int>(stage));
+    append(path.size());
+    key += path;
+
+    if (!builder.m_constants.contains(stage)) {
+      append(0);
+      continue;
+    }
+
+    append(builder.m_constants.at(stage).size());
+    for (auto [id, value] : builder.m_constants.at(stage)) {
+      append(id);
+      append(value);
+    }
+  }
+
+  PipelineState state = pipelineState(engine, builder, depthOnly);
+  append(builder.m_vertexPulling);
+  append(depthOnly);
+  append(usesPrepass(engine, builder));
+  append(static_cast<unsigned int>(state.topology));
+  append(static_cast<unsigned int>(state.polygonMode));
+  append(static_cast<unsigned int>(state.cullMode));
+  append(static_cast<unsigned int>(state.frontFace));
+  append(state.depthTest);
+  append(state.depthWrite);
+  append(static_cast<unsigned int>(state.depthCompare));
+  append(state.blendMode);
+
+  return PipelineKey{ .hash = ShaderRegistry::hash(key.data(), key.size()), .state = std::move(key) };
+}
+
+unsigned int MaterialManager::variant(
+  const Engine& engine,
+  const Builder& builder,
+  bool depthOnly,
+  std::vector<std::pair<const Builder *, bool>>& jobs
+) {
+  auto [it, inserted] = m_variants.emplace(pipelineKey(engine, builder, depthOnly), m_pipelines.size());
+  if (inserted) {
+    jobs.emplace_back(&builder, depthOnly);
+    m_pipelines.emplace_back(nullptr);
+  }
+
+  return it->second;
+}
+
+void MaterialManager::prepareMaterial(
+  const Engine& engine,
+  const std::string& tag,
+  Material& material,
+  std::vector<std::pair<const Builder *, bool>>& jobs
+) {
+  const Builder& builder = m_builders[material.builder];
+  const PipelineState& state = builder.m_state;
+  if (state.blendMode != OpaqueBlending)
+    m_transparent.insert(tag);
+
+  if (material.index >= ge_max_descriptors)
+    throw std::runtime_error("groot-engine: material limit of " + std::to_string(ge_max_descriptors) + " reached");
+
+  material.pipeline = variant(engine, builder, false, jobs);
+  material.prepass = usesPrepass(engine, builder);
+
+  if (material.prepass)
+    material.depthPipeline = variant(engine, builder, true, jobs);
+
+  MaterialData data;
+  for (unsigned int i = 0; i < builder.m_textures.size(); ++i) {
+    data.textures[i] = engine.m_textures.index(builder.m_textures[i].first);
+    data.samplers[i] = builder.m_textures[i].second;
+  }
+
+  memcpy(reinterpret_cast<MaterialData *>(m_materialMap) + material.index, &data, sizeof(MaterialData));
+
+  for (const Builder::Parameter& parameter : builder.m_parameters)
+    writeParameter(materialParameter(parameter.column, material.index), ge_max_descriptors, parameter.value);
 }
 
 void MaterialManager::createLayout(const Engine& engine, unsigned int transformCount) {
-  vk::DescriptorSetLayoutBinding transformBinding{
+  vk::DescriptorSetLayoutBinding bindings[6] = {
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 0,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eVertex
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 1,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eCompute
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 2,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 3,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 4,
+      .descriptorType   = vk::DescriptorType::eSampler,
+      .descriptorCount  = TextureManager::sampler_count,
+      .stageFlags       = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 5,
+      .descriptorType   = vk::DescriptorType::eSampledImage,
+      .descriptorCount  = ge_max_descriptors,
+      .stageFlags       = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment
+    }
+  };
+
+  vk::DescriptorBindingFlags bindingFlags[6] = {
+    {},
+    {},
+    {},
+    {},
+    {},
+    vk::DescriptorBindingFlagBits::ePartiallyBound |
+    vk::DescriptorBindingFlagBits::eUpdateAfterBind |
+    vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending |
+    vk::DescriptorBindingFlagBits::eVariableDescriptorCount
+  };
+
+  vk::DescriptorSetLayoutBindingFlagsCreateInfo ci_flags{
+    .bindingCount   = 6,
+    .pBindingFlags  = bindingFlags
+  };
+
+  m_setLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .pNext        = &ci_flags,
+    .flags        = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+    .bindingCount = 6,
+    .pBindings    = bindings
+  });
+
+  vk::DescriptorSetLayoutBinding vertexBinding{
     .binding          = 0,
     .descriptorType   = vk::DescriptorType::eStorageBuffer,
     .descriptorCount  = 1,
     .stageFlags       = vk::ShaderStageFlagBits::eVertex
   };
 
-  m_setLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+  m_vertexSetLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
     .bindingCount = 1,
-    .pBindings    = &transformBinding
+    .pBindings    = &vertexBinding
   });
 
+  vk::DescriptorSetLayoutBinding cameraBinding{
+    .binding          = 0,
+    .descriptorType   = vk::DescriptorType::eUniformBufferDynamic,
+    .descriptorCount  = 1,
+    .stageFlags       = all_stages
+  };
+
+  m_cameraSetLayout = engine.m_context.device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .bindingCount = 1,
+    .pBindings    = &cameraBinding
+  });
+
+  vk::DescriptorSetLayout setLayouts[3] = { *m_setLayout, *m_cameraSetLayout, *m_vertexSetLayout };
+
   vk::PushConstantRange range{
     .stageFlags = all_stages,
     .size       = sizeof(EngineData)
   };
 
   m_layout = engine.m_context.device().createPipelineLayout(vk::PipelineLayoutCreateInfo{
-    .setLayoutCount         = 1,
-    .pSetLayouts            = &*m_setLayout,
+    .setLayoutCount         = 3,
+    .pSetLayouts            = setLayouts,
     .pushConstantRangeCount = 1,
     .pPushConstantRanges    = &range
   });
 }
 
-void MaterialManager::createPipeline(const Engine& engine, const Builder& builder) {
-    auto [modules, ci_stages] = getShaderStages(engine, builder);
+vk::raii::Pipeline MaterialManager::createPipeline(
+  const Engine& engine,
+  const Builder& builder,
+  bool depthOnly,
+  vk::GraphicsPipelineLibraryFlagsEXT parts
+) const {
+  ShaderStages stages = getShaderStages(engine, builder);
+  PipelineState state = pipelineState(engine, builder, depthOnly);
+
+  return createPipeline(engine, stages, builder.m_vertexPulling, state, depthOnly, parts);
+}
+
+vk::raii::Pipeline MaterialManager::createPipeline(
+  const Engine& engine,
+  ShaderStages& stages,
+  bool vertexPulling,
+  const PipelineState& state,
+  bool depthOnly,
+  vk::GraphicsPipelineLibraryFlagsEXT parts
+) const {
+  bool library = static_cast<bool>(parts);
+
+  std::erase_if(stages.infos, [depthOnly, library, parts](const vk::PipelineShaderStageCreateInfo& info) {
+    bool fragment = info.stage == vk::ShaderStageFlagBits::eFragment;
+    if (fragment && depthOnly) return true;
+    if (!library) return false;
+
+    return fragment ?
+      !(parts & vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader) :
+      !(parts & vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders);
+  });
 
   vk::DynamicState dynStates[2] = {
     vk::DynamicState::eViewport,
@@ -146,8 +847,8 @@ void MaterialManager::createPipeline(const Engine& engine, const Builder& builde
     .scissorCount   = 1
   };
 
-  auto vertBinding = Vertex::binding();
-  auto vertAttribs = Vertex::attributes();
+  auto vertBinding = Vertex::binding(engine.m_settings.vertex_format);
+  auto vertAttribs = Vertex::attributes(engine.m_settings.vertex_format);
 
   vk::PipelineVertexInputStateCreateInfo ci_input{
     .vertexBindingDescriptionCount    = 1,
@@ -156,17 +857,20 @@ void MaterialManager::createPipeline(const Engine& engine, const Builder& builde
     .pVertexAttributeDescriptions     = vertAttribs.data()
   };
 
+  if (vertexPulling)
+    ci_input = vk::PipelineVertexInputStateCreateInfo{};
+
   vk::PipelineInputAssemblyStateCreateInfo ci_assembly{
-    .topology               = vk::PrimitiveTopology::eTriangleList,
+    .topology               = state.topology,
     .primitiveRestartEnable = false
   };
 
   vk::PipelineRasterizationStateCreateInfo ci_rasterizer{
     .depthClampEnable         = false,
     .rasterizerDiscardEnable  = false,
-    .polygonMode              = vk::PolygonMode::eFill,
-    .cullMode                 = vk::CullModeFlagBits::eBack,
-    .frontFace                = vk::FrontFace::eCounterClockwise,
+    .polygonMode              = state.polygonMode,
+    .cullMode                 = state.cullMode,
+    .frontFace                = state.frontFace,
     .depthBiasEnable          = false,
     .lineWidth                = 1.0f
   };
@@ -177,15 +881,15 @@ void MaterialManager::createPipeline(const Engine& engine, const Builder& builde
   };
 
   vk::PipelineDepthStencilStateCreateInfo ci_depth{
-    .depthTestEnable        = true,
-    .depthWriteEnable       = true,
-    .depthCompareOp         = vk::CompareOp::eLess,
+    .depthTestEnable        = state.depthTest,
+    .depthWriteEnable       = state.depthWrite,
+    .depthCompareOp         = state.depthCompare,
     .depthBoundsTestEnable  = false,
     .stencilTestEnable      = false
   };
 
   vk::PipelineColorBlendAttachmentState colorAttachment{
-    .blendEnable          = true,
+    .blendEnable          = state.blendMode != OpaqueBlending,
     .srcColorBlendFactor  = vk::BlendFactor::eSrcAlpha,
     .dstColorBlendFactor  = vk::BlendFactor::eOneMinusSrcAlpha,
     .colorBlendOp         = vk::BlendOp::eAdd,
@@ -198,6 +902,12 @@ void MaterialManager::createPipeline(const Engine& engine, const Builder& builde
                             vk::ColorComponentFlagBits::eA
   };
 
+  if (state.blendMode == AdditiveBlending)
+    colorAttachment.dstColorBlendFactor = vk::BlendFactor::eOne;
+
+  if (depthOnly)
+    colorAttachment.colorWriteMask = vk::ColorComponentFlags();
+
   vk::PipelineColorBlendStateCreateInfo ci_blend{
     .logicOpEnable    = false,
     .attachmentCount  = 1,
@@ -210,10 +920,20 @@ void MaterialManager::createPipeline(const Engine& engine, const Builder& builde
     .depthAttachmentFormat    = engine.m_settings.depth_format
   };
 
-  m_pipelines.emplace_back(engine.m_context.device().createGraphicsPipeline(nullptr, vk::GraphicsPipelineCreateInfo{
-    .pNext                = &ci_rendering,
-    .stageCount           = static_cast<unsigned int>(ci_stages.size()),
-    .pStages              = ci_stages.data(),
+  vk::GraphicsPipelineLibraryCreateInfoEXT ci_library{
+    .pNext  = &ci_rendering,
+    .flags  = parts
+  };
+
+  vk::PipelineCreateFlags flags;
+  if (library)
+    flags = vk::PipelineCreateFlagBits::eLibraryKHR | vk::PipelineCreateFlagBits::eRetainLinkTimeOptimizationInfoEXT;
+
+  return engine.m_pipelineCache.createGraphicsPipeline(engine, vk::GraphicsPipelineCreateInfo{
+    .pNext                = library ? static_cast<const void *>(&ci_library) : &ci_rendering,
+    .flags                = flags,
+    .stageCount           = static_cast<unsigned int>(stages.infos.size()),
+    .pStages              = stages.infos.data(),
     .pVertexInputState    = &ci_input,
     .pInputAssemblyState  = &ci_assembly,
     .pViewportState       = &ci_viewport,
@@ -223,17 +943,213 @@ void MaterialManager::createPipeline(const Engine& engine, const Builder& builde
     .pColorBlendState     = &ci_blend,
     .pDynamicState        = &ci_dynState,
     .layout               = m_layout
-  }));
+  });
+}
+
+void MaterialManager::createFallbacks(const Engine& engine) {
+  vk::raii::ShaderModule vertModule = engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
+    .codeSize = sizeof(fallbackVertCode),
+    .pCode    = fallbackVertCode
+  });
+
+  vk::raii::ShaderModule pullModule = engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
+    .codeSize = sizeof(fallbackPullCode),
+    .pCode    = fallbackPullCode
+  });
+
+  vk::raii::ShaderModule fragModule = engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
+    .codeSize = sizeof(fallbackFragCode),
+    .pCode    = fallbackFragCode
+  });
+
+  PipelineState state{
+    .cullMode     = vk::CullModeFlagBits::eNone,
+    .depthCompare = vk::CompareOp::eLessOrEqual
+  };
+
+  ShaderStages stages;
+  stages.infos = {
+    vk::PipelineShaderStageCreateInfo{
+      .stage  = vk::ShaderStageFlagBits::eVertex,
+      .module = vertModule,
+      .pName  = "main"
+    },
+    vk::PipelineShaderStageCreateInfo{
+      .stage  = vk::ShaderStageFlagBits::eFragment,
+      .module = fragModule,
+      .pName  = "main"
+    }
+  };
+
+  m_fallback = createPipeline(engine, stages, false, state, false, {});
+
+  unsigned int stride = Vertex::size(engine.m_settings.vertex_format) / sizeof(float);
+  vk::SpecializationMapEntry entry{
+    .constantID = 0,
+    .offset     = 0,
+    .size       = sizeof(unsigned int)
+  };
+
+  vk::SpecializationInfo specialization{
+    .mapEntryCount  = 1,
+    .pMapEntries    = &entry,
+    .dataSize       = sizeof(unsigned int),
+    .pData          = &stride
+  };
+
+  stages.infos[0].module = pullModule;
+  stages.infos[0].pSpecializationInfo = &specialization;
+
+  m_pulledFallback = createPipeline(engine, stages, true, state, false, {});
 }
 
-void MaterialManager::createDescriptors(const Engine& engine, const std::vector<mat4>& transforms) {
+void MaterialManager::compilePipelines(const Engine& engine, const std::vector<std::pair<const Builder *, bool>>& jobs) {
+  unsigned int first = m_pipelines.size() - jobs.size();
+  unsigned int workers = std::max(std::thread::hardware_concurrency(), 1u);
+
+  std::lock_guard lock(m_jobMutex);
+  for (unsigned int i = 0; i < jobs.size(); ++i) {
+    m_jobs.emplace_back(CompileJob{
+      .builder    = jobs[i].first,
+      .depthOnly  = jobs[i].second,
+      .index      = first + i
+    });
+  }
+
+  while (m_workers < workers && m_workers < m_jobs.size() - m_nextJob) {
+    ++m_workers;
+    m_compiling.emplace_back(std::async(std::launch::async, [this, &engine]() { compileWorker(engine); }));
+  }
+}
+
+void MaterialManager::compileWorker(const Engine& engine) {
+  while (true) {
+    CompileJob job;
+    {
+      std::lock_guard lock(m_jobMutex);
+      if (m_stopping || m_nextJob == m_jobs.size()) {
+        if (m_nextJob == m_jobs.size()) {
+          m_jobs.clear();
+          m_nextJob = 0;
+        }
+        --m_workers;
+        return;
+      }
+      job = m_jobs[m_nextJob++];
+    }
+
+    vk::raii::Pipeline pipeline = nullptr;
+    try {
+      pipeline = createPipeline(engine, *job.builder, job.depthOnly);
+    }
+    catch (...) {
+      std::lock_guard lock(m_jobMutex);
+      --m_workers;
+      throw;
+    }
+
+    std::lock_guard lock(m_readyMutex);
+    m_ready.emplace_back(job.index, std::move(pipeline));
+  }
+}
+
+void MaterialManager::createLibraries(const Engine& engine, const std::vector<std::pair<const Builder *, bool>>& jobs) {
+  m_libraries.clear();
+
+  for (const auto& [builder, depthOnly] : jobs) {
+    PipelineState state = pipelineState(engine, *builder, depthOnly);
+
+    std::pair inputKey(builder->m_vertexPulling, state.topology);
+    if (!m_vertexInputLibraries.contains(inputKey)) {
+      m_vertexInputLibraries.emplace(inputKey, createPipeline(engine, *builder, depthOnly,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface
+      ));
+    }
+
+    std::pair outputKey(state.blendMode, depthOnly);
+    if (!m_outputLibraries.contains(outputKey)) {
+      m_outputLibraries.emplace(outputKey, createPipeline(engine, *builder, depthOnly,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface
+      ));
+    }
+
+    m_libraries.emplace_back(Libraries{
+      .vertexInput    = *m_vertexInputLibraries.at(inputKey),
+      .fragmentOutput = *m_outputLibraries.at(outputKey)
+    });
+  }
+}
+
+vk::raii::Pipeline MaterialManager::linkPipeline(const Engine& engine, const Libraries& library, bool optimize) const {
+  vk::Pipeline libraries[4] = {
+    library.vertexInput,
+    *library.preRasterization,
+    *library.fragmentShader,
+    library.fragmentOutput
+  };
+
+  vk::PipelineLibraryCreateInfoKHR ci_libraries{
+    .libraryCount = 4,
+    .pLibraries   = libraries
+  };
+
+  vk::PipelineCreateFlags flags;
+  if (optimize)
+    flags = vk::PipelineCreateFlagBits::eLinkTimeOptimizationEXT;
+
+  return engine.m_pipelineCache.createGraphicsPipeline(engine, vk::GraphicsPipelineCreateInfo{
+    .pNext  = &ci_libraries,
+    .flags  = flags,
+    .layout = m_layout
+  });
+}
+
+void MaterialManager::optimizePipelines(const Engine& engine) {
+  // depth and colour pipelines of a prepass material are swapped together
+  std::vector<unsigned int> roots(m_libraries.size());
+  std::iota(roots.begin(), roots.end(), 0);
+  auto root = [&roots](unsigned int i) {
+    while (roots[i] != i) i = roots[i] = roots[roots[i]];
+    return i;
+  };
+
+  for (const auto& [tag, material] : m_materials) {
+    if (material.prepass)
+      roots[root(material.depthPipeline)] = root(material.pipeline);
+  }
+
+  std::map<unsigned int, std::vector<unsigned int>> groups;
+  for (unsigned int i = 0; i < m_libraries.size(); ++i)
+    groups[root(i)].emplace_back(i);
+
+  m_optimizer = std::async(std::launch::async, [this, &engine, groups = std::move(groups)]() {
+    for (auto it = groups.begin(); it != groups.end() && !m_stopping; ++it) {
+      std::vector<std::pair<unsigned int, vk::raii::Pipeline>> pipelines;
+      for (unsigned int i : it->second)
+        pipelines.emplace_back(i, linkPipeline(engine, m_libraries[i], true));
+
+      std::lock_guard lock(m_readyMutex);
+      for (auto& pipeline : pipelines)
+        m_ready.emplace_back(std::move(pipeline));
+    }
+  });
+}
+
+void MaterialManager::createDescriptors(const Engine& engine, const std::vector<mat4>& transforms, const BoundsArray& bounds) {
   std::vector<vk::BufferCreateInfo> transformInfos;
+  std::vector<vk::BufferCreateInfo> boundsInfos;
   for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
     transformInfos.emplace_back(vk::BufferCreateInfo{
       .size         = static_cast<unsigned int>(sizeof(mat4) * transforms.size()),
       .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
       .sharingMode  = vk::SharingMode::eExclusive
     });
+
+    boundsInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = bounds.bytes(),
+      .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
   }
 
   auto [tmp_transMem, tmp_transBufs, tmp_transOffs, transSize] = Allocator::bufferPool(engine, transformInfos,
@@ -243,25 +1159,192 @@ void MaterialManager::createDescriptors(const Engine& engine, const std::vector<
   m_transformBuffers = std::move(tmp_transBufs);
   m_transformOffsets = std::move(tmp_transOffs);
 
+  auto [tmp_boundsMem, tmp_boundsBufs, tmp_boundsOffs, boundsSize] = Allocator::bufferPool(engine, boundsInfos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_boundsMemory = std::move(tmp_boundsMem);
+  m_boundsBuffers = std::move(tmp_boundsBufs);
+  m_boundsOffsets = std::move(tmp_boundsOffs);
+
+  auto [tmp_matMem, tmp_matBufs, _o, matSize] = Allocator::bufferPool(engine, {
+      vk::BufferCreateInfo{
+        .size         = sizeof(MaterialData) * ge_max_descriptors,
+        .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
+        .sharingMode  = vk::SharingMode::eExclusive
+      }
+    },
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_materialMemory = std::move(tmp_matMem);
+  m_materialBuffer = std::move(tmp_matBufs[0]);
+
   m_transformMap = m_transformMemory.mapMemory(0, transSize);
-  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i)
+  m_boundsMap = m_boundsMemory.mapMemory(0, boundsSize);
+  m_materialMap = m_materialMemory.mapMemory(0, matSize);
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
     updateTransforms(i, transforms);
+    updateBounds(i, bounds);
+  }
+}
+
+void MaterialManager::createCameras(const Engine& engine) {
+  unsigned int alignment = engine.m_context.gpu().getProperties().limits.minUniformBufferOffsetAlignment;
+  m_cameraStride = (sizeof(CameraData) + alignment - 1) / alignment * alignment;
+
+  auto [tmp_cameraMem, tmp_cameraBufs, _o, cameraSize] = Allocator::bufferPool(engine, {
+      vk::BufferCreateInfo{
+        .size         = engine.m_settings.buffer_mode * m_cameraStride,
+        .usage        = vk::BufferUsageFlagBits::eUniformBuffer,
+        .sharingMode  = vk::SharingMode::eExclusive
+      }
+    },
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_cameraMemory = std::move(tmp_cameraMem);
+  m_cameraBuffer = std::move(tmp_cameraBufs[0]);
+  m_cameraMap = m_cameraMemory.mapMemory(0, cameraSize);
+
+  vk::DescriptorBufferInfo info{
+    .buffer = m_cameraBuffer,
+    .range  = sizeof(CameraData)
+  };
+
+  engine.m_context.device().updateDescriptorSets(vk::WriteDescriptorSet{
+    .dstSet           = m_cameraSets[0],
+    .dstBinding       = 0,
+    .descriptorCount  = 1,
+    .descriptorType   = vk::DescriptorType::eUniformBufferDynamic,
+    .pBufferInfo      = &info
+  }, nullptr);
+}
+
+void MaterialManager::createParameters(
+  const Engine& engine,
+  unsigned int transformCount,
+  const std::map<const Transform *, std::string>& objects
+) {
+  m_objectStride = transformCount;
+
+  unsigned int objectColumns = 0;
+  for (const Builder& builder : m_builders) {
+    if (builder.m_objectParameters.empty()) continue;
+
+    const Builder::Parameter& last = builder.m_objectParameters.back();
+    objectColumns = std::max(objectColumns, last.column + last.value.size());
+  }
+
+  std::array<unsigned int, 3> header = parameterHeader(m_objectStride);
+  m_parameterData.assign(objectParameter(objectColumns, 0, m_objectStride), 0);
+  std::copy(header.begin(), header.end(), m_parameterData.begin());
+
+  for (const auto& [object, tag] : objects) {
+    for (const Builder::Parameter& parameter : m_builders[m_materials.at(tag).builder].m_objectParameters)
+      writeParameter(objectParameter(parameter.column, object->m_index, m_objectStride), m_objectStride, parameter.value);
+  }
+
+  for (const auto& [object, column, value] : m_objectValues)
+    writeParameter(objectParameter(column, object->m_index, m_objectStride), m_objectStride, value);
+  m_objectValues.clear();
+
+  std::vector<vk::BufferCreateInfo> infos;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    infos.emplace_back(vk::BufferCreateInfo{
+      .size         = sizeof(unsigned int) * m_parameterData.size(),
+      .usage        = vk::BufferUsageFlagBits::eStorageBuffer,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+  }
+
+  auto [tmp_paramMem, tmp_paramBufs, tmp_paramOffs, paramSize] = Allocator::bufferPool(engine, infos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_parameterMemory = std::move(tmp_paramMem);
+  m_parameterBuffers = std::move(tmp_paramBufs);
+  m_parameterOffsets = std::move(tmp_paramOffs);
+  m_parameterMap = m_parameterMemory.mapMemory(0, paramSize);
+
+  m_dirtyParameters.resize(engine.m_settings.buffer_mode);
+}
+
+std::array<unsigned int, 3> MaterialManager::parameterHeader(unsigned int objectStride) {
+  return { ge_max_descriptors, objectStride, max_parameters * ge_max_descriptors };
+}
+
+unsigned int MaterialManager::materialParameter(unsigned int column, unsigned int material) {
+  return parameterHeaderSize + column * ge_max_descriptors + material;
+}
+
+unsigned int MaterialManager::objectParameter(unsigned int column, unsigned int transform, unsigned int objectStride) {
+  return parameterHeaderSize + max_parameters * ge_max_descriptors + column * objectStride + transform;
+}
+
+void MaterialManager::writeParameter(unsigned int offset, unsigned int stride, const ParameterValue& value) {
+  for (unsigned int i = 0; i < value.size(); ++i)
+    m_parameterData[offset + i * stride] = value.words[i];
+
+  for (auto& ranges : m_dirtyParameters) {
+    for (unsigned int i = 0; i < value.size(); ++i)
+      ranges.emplace_back(offset + i * stride, offset + i * stride + 1);
+  }
 }
 
 void MaterialManager::updateSets(const Engine& engine) {
+  std::vector<vk::DescriptorBufferInfo> infos;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_transformBuffers[i], .range = vk::WholeSize });
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_boundsBuffers[i], .range = vk::WholeSize });
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_materialBuffer, .range = vk::WholeSize });
+    infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = m_parameterBuffers[i], .range = vk::WholeSize });
+  }
+
+  std::vector<vk::DescriptorImageInfo> samplers;
+  for (unsigned int i = 0; i < TextureManager::sampler_count; ++i)
+    samplers.emplace_back(vk::DescriptorImageInfo{ .sampler = engine.m_textures.sampler(static_cast<SamplerType>(i)) });
+
   std::vector<vk::WriteDescriptorSet> writes;
   for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
-    vk::DescriptorBufferInfo info{
-      .buffer = m_transformBuffers[i],
-      .range  = vk::WholeSize
-    };
+    for (unsigned int binding = 0; binding < 4; ++binding) {
+      writes.emplace_back(vk::WriteDescriptorSet{
+        .dstSet           = m_sets[i],
+        .dstBinding       = binding,
+        .descriptorCount  = 1,
+        .descriptorType   = vk::DescriptorType::eStorageBuffer,
+        .pBufferInfo      = &infos[i * 4 + binding]
+      });
+    }
 
     writes.emplace_back(vk::WriteDescriptorSet{
       .dstSet           = m_sets[i],
-      .dstBinding       = 0,
-      .descriptorCount  = 1,
-      .descriptorType   = vk::DescriptorType::eStorageBuffer,
-      .pBufferInfo      = &info
+      .dstBinding       = 4,
+      .descriptorCount  = TextureManager::sampler_count,
+      .descriptorType   = vk::DescriptorType::eSampler,
+      .pImageInfo       = samplers.data()
+    });
+  }
+
+  engine.m_context.device().updateDescriptorSets(writes, nullptr);
+  updateTextures(engine, 0);
+}
+
+void MaterialManager::updateTextures(const Engine& engine, unsigned int first) {
+  std::vector<vk::DescriptorImageInfo> images;
+  for (unsigned int i = first; i < engine.m_textures.count(); ++i) {
+    images.emplace_back(vk::DescriptorImageInfo{
+      .imageView    = engine.m_textures.view(i),
+      .imageLayout  = vk::ImageLayout::eShaderReadOnlyOptimal
+    });
+  }
+  if (images.empty()) return;
+
+  std::vector<vk::WriteDescriptorSet> writes;
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = m_sets[i],
+      .dstBinding       = 5,
+      .dstArrayElement  = first,
+      .descriptorCount  = static_cast<unsigned int>(images.size()),
+      .descriptorType   = vk::DescriptorType::eSampledImage,
+      .pImageInfo       = images.data()
     });
   }
 
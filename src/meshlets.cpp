@@ -0,0 +1,163 @@
+#include "src/include/meshlets.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ge {
+
+MeshletBuilder::Output MeshletBuilder::build(
+  const std::vector<Vertex>& vertices,
+  const std::vector<unsigned int>& indices,
+  unsigned int maxVertices,
+  unsigned int maxTriangles
+) {
+  return build(vertices.data(), vertices.size(), indices.data(), indices.size(), maxVertices, maxTriangles);
+}
+
+MeshletBuilder::Output MeshletBuilder::build(
+  const Vertex * vertices,
+  unsigned int vertexCount,
+  const unsigned int * indices,
+  unsigned int indexCount,
+  unsigned int maxVertices,
+  unsigned int maxTriangles
+) {
+  maxVertices = std::max(maxVertices, 3u);
+  maxTriangles = std::max(maxTriangles, 1u);
+
+  unsigned int triangleCount = indexCount / 3;
+
+  std::vector<unsigned int> offsets(vertexCount + 1, 0);
+  for (unsigned int i = 0; i < triangleCount * 3; ++i)
+    ++offsets[indices[i] + 1];
+  for (unsigned int v = 0; v < vertexCount; ++v)
+    offsets[v + 1] += offsets[v];
+
+  std::vector<unsigned int> adjacency(triangleCount * 3);
+  std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+  for (unsigned int t = 0; t < triangleCount; ++t) {
+    for (unsigned int k = 0; k < 3; ++k)
+      adjacency[cursor[indices[t * 3 + k]]++] = t;
+  }
+
+  std::vector<Meshlet> meshlets;
+  std::vector<unsigned int> output;
+  output.reserve(triangleCount * 3);
+
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<unsigned int> stamps(vertexCount, 0);
+  std::vector<unsigned int> meshletVertices;
+  unsigned int seed = 0;
+  unsigned int remaining = triangleCount;
+
+  auto newVertices = [&](unsigned int t, unsigned int stamp) {
+    unsigned int count = 0;
+    for (unsigned int k = 0; k < 3; ++k) {
+      unsigned int v = indices[t * 3 + k];
+      bool repeated = (k > 0 && indices[t * 3] == v) || (k > 1 && indices[t * 3 + 1] == v);
+      if (stamps[v] != stamp && !repeated) ++count;
+    }
+    return count;
+  };
+
+  while (remaining > 0) {
+    unsigned int stamp = meshlets.size() + 1;
+    Meshlet meshlet{ .firstIndex = static_cast<unsigned int>(output.size()) };
+    meshletVertices.clear();
+
+    while (emitted[seed]) ++seed;
+    unsigned int next = seed;
+
+    while (next != std::numeric_limits<unsigned int>::max()) {
+      for (unsigned int k = 0; k < 3; ++k) {
+        unsigned int v = indices[next * 3 + k];
+        if (stamps[v] != stamp) {
+          stamps[v] = stamp;
+          meshletVertices.emplace_back(v);
+        }
+        output.emplace_back(v);
+      }
+
+      emitted[next] = true;
+      --remaining;
+      meshlet.indexCount += 3;
+
+      next = std::numeric_limits<unsigned int>::max();
+      if (meshlet.indexCount / 3 >= maxTriangles) break;
+
+      unsigned int best = 4;
+      for (unsigned int v : meshletVertices) {
+        for (unsigned int a = offsets[v]; a < offsets[v + 1]; ++a) {
+          unsigned int t = adjacency[a];
+          if (emitted[t]) continue;
+
+          unsigned int extra = newVertices(t, stamp);
+          if (extra < best && meshletVertices.size() + extra <= maxVertices) {
+            best = extra;
+            next = t;
+          }
+        }
+
+        if (best == 0) break;
+      }
+
+      if (next == std::numeric_limits<unsigned int>::max() && remaining > 0) {
+        while (emitted[seed]) ++seed;
+        if (meshletVertices.size() + newVertices(seed, stamp) <= maxVertices)
+          next = seed;
+      }
+    }
+
+    meshlet.vertexCount = meshletVertices.size();
+    finish(vertices, output.data(), meshlet);
+    meshlets.emplace_back(meshlet);
+  }
+
+  return { std::move(meshlets), std::move(output) };
+}
+
+void MeshletBuilder::finish(const Vertex * vertices, const unsigned int * indices, Meshlet& meshlet) {
+  const unsigned int * first = indices + meshlet.firstIndex;
+
+  vec3 lo = vertices[first[0]].m_position;
+  vec3 hi = lo;
+  for (unsigned int i = 1; i < meshlet.indexCount; ++i) {
+    const vec3& p = vertices[first[i]].m_position;
+    lo = vec3(std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z));
+    hi = vec3(std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z));
+  }
+  meshlet.bounds = Bounds(lo, hi);
+
+  std::vector<vec3> normals;
+  vec3 sum(0.0f);
+  for (unsigned int i = 0; i < meshlet.indexCount; i += 3) {
+    const vec3& a = vertices[first[i]].m_position;
+    const vec3& b = vertices[first[i + 1]].m_position;
+    const vec3& c = vertices[first[i + 2]].m_position;
+
+    vec3 normal = (b - a).cross(c - a);
+    float length = normal.magnitude();
+    if (length <= std::numeric_limits<float>::epsilon()) continue;
+
+    normals.emplace_back(normal / length);
+    sum += normals.back();
+  }
+
+  float length = sum.magnitude();
+  if (normals.empty() || length <= std::numeric_limits<float>::epsilon()) {
+    meshlet.coneAxis = vec3(0.0f);
+    meshlet.coneCutoff = 1.0f;
+    return;
+  }
+
+  meshlet.coneAxis = sum / length;
+
+  float spread = 1.0f;
+  for (const auto& normal : normals)
+    spread = std::min(spread, normal * meshlet.coneAxis);
+
+  meshlet.coneCutoff = spread <= 0.1f ? 1.0f : std::sqrt(1.0f - spread * spread);
+}
+
+} // namespace ge
@@ -1,19 +1,43 @@
 #include "src/include/allocator.hpp"
 #include "src/include/engine.hpp"
 #include "src/include/objects.hpp"
+#include "src/include/optimizer.hpp"
 #include "src/include/parsers.hpp"
+#include "src/include/simplifier.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace ge {
 
-const ObjectManager::Output ObjectManager::operator[](std::string material) const {
+const ObjectManager::Output ObjectManager::staticObjects(std::string material, unsigned int frameIndex) const {
   const ObjectData& obj = m_objects.at(material);
 
   return {
     m_vertexBuffers[obj.bufferIndex],
     m_indexBuffers[obj.bufferIndex],
-    m_indirectBuffers[obj.bufferIndex],
+    m_indirectBuffers[frameIndex],
+    m_vertexSets[obj.bufferIndex],
+    obj.indexType,
+    obj.commands.size(),
+    obj.transformIndex,
+    obj.batchIndex
+  };
+}
+
+const ObjectManager::Output ObjectManager::dynamicObjects(std::string material, unsigned int frameIndex) const {
+  const ObjectData& obj = m_dynamicObjects.at(material);
+
+  return {
+    m_dynamicBuffers[obj.bufferIndex * m_bufferCount + frameIndex],
+    m_dynamicIndexBuffers[obj.bufferIndex],
+    m_indirectBuffers[frameIndex],
+    m_vertexSets[m_vertexBuffers.size() + obj.bufferIndex * m_bufferCount + frameIndex],
+    obj.indexType,
     obj.commands.size(),
-    obj.transformIndex
+    obj.transformIndex,
+    obj.batchIndex
   };
 }
 
@@ -21,6 +45,10 @@ bool ObjectManager::hasObjects(std::string material) const {
   return m_objects.contains(material);
 }
 
+bool ObjectManager::hasDynamicObjects(std::string material) const {
+  return m_dynamicObjects.contains(material);
+}
+
 unsigned int ObjectManager::commandSize() const {
   return sizeof(IndirectCommand);
 }
@@ -29,8 +57,89 @@ const std::vector<mat4>& ObjectManager::transforms() const {
   return m_transforms;
 }
 
+const BoundsArray& ObjectManager::bounds() const {
+  return m_worldBounds;
+}
+
+unsigned int ObjectManager::batchCount() const {
+  return m_batchCount;
+}
+
+const std::vector<CullData>& ObjectManager::cullData() const {
+  return m_cullData;
+}
+
+const unsigned int& ObjectManager::cullVersion() const {
+  return m_cullVersion;
+}
+
+const std::vector<ClusterData>& ObjectManager::clusterData() const {
+  return m_clusterData;
+}
+
+std::pair<unsigned int, unsigned int> ObjectManager::clusters(unsigned int batchIndex) const {
+  return m_batchClusters[batchIndex];
+}
+
+const vk::raii::Buffer& ObjectManager::indirectBuffer(unsigned int frameIndex) const {
+  return m_indirectBuffers[frameIndex];
+}
+
+std::vector<Occluder> ObjectManager::occluders() const {
+  std::vector<Occluder> occluders;
+
+  for (const Transform * object : m_occluders) {
+    for (const auto * objects : { &m_objects, &m_dynamicObjects }) {
+      for (const auto& [material, obj] : *objects) {
+        if (object->m_index < obj.transformIndex || object->m_index >= obj.transformIndex + obj.transforms.size())
+          continue;
+
+        const IndirectCommand& command = obj.commands[object->m_index - obj.transformIndex];
+        occluders.emplace_back(Occluder{
+          .transform  = m_transforms[object->m_index],
+          .vertices   = obj.vertices.data() + command.vertexOffset,
+          .indices    = obj.indices.data() + command.firstIndex,
+          .indexCount = command.indexCount
+        });
+      }
+    }
+  }
+
+  return occluders;
+}
+
+const std::vector<std::string>& ObjectManager::drawOrder() const {
+  return m_drawOrder;
+}
+
+const std::map<const Transform *, std::string>& ObjectManager::materials() const {
+  return m_objectMaterials;
+}
+
+const std::string& ObjectManager::material(const transform& object) const {
+  if (object->m_manager != this)
+    throw std::runtime_error("groot-engine: object does not belong to this engine");
+
+  return m_objectMaterials.at(object.get());
+}
+
+OptimizationReport ObjectManager::optimization(const transform& object) const {
+  if (object->m_manager != this)
+    throw std::runtime_error("groot-engine: object does not belong to this engine");
+
+  return m_reports.at(object.get());
+}
+
+Bounds ObjectManager::bounds(const transform& object) const {
+  if (object->m_manager != this || object->m_index >= m_worldBounds.size())
+    throw std::runtime_error("groot-engine: bounds are unavailable until the object is loaded");
+
+  return m_worldBounds[object->m_index];
+}
+
 transform ObjectManager::add(const std::string& material, const std::string& path, const Transform& transform) {
   auto [vertices, indices] = ObjParser::parse(path);
+  OptimizationReport report = MeshOptimizer::optimize(vertices, indices);
 
   ObjectData& obj = m_objects[material];
   obj.commands.emplace_back(IndirectCommand{
@@ -40,145 +149,642 @@ transform ObjectManager::add(const std::string& material, const std::string& pat
     .vertexOffset   = static_cast<unsigned int>(obj.vertices.size()),
     .firstInstance  = static_cast<unsigned int>(obj.commands.size())
   });
+  obj.bounds.emplace_back(Bounds::compute(vertices));
   obj.vertices.insert(obj.vertices.end(), vertices.begin(), vertices.end());
   obj.indices.insert(obj.indices.end(), indices.begin(), indices.end());
   obj.transforms.emplace_back(std::make_shared<Transform>(transform));
 
   obj.transforms.back()->m_manager = this;
+  m_objectMaterials.emplace(obj.transforms.back().get(), material);
+  m_reports.emplace(obj.transforms.back().get(), report);
+  return obj.transforms.back();
+}
+
+transform ObjectManager::addDynamic(const std::string& material, const std::string& path, const Transform& transform) {
+  auto [vertices, indices] = ObjParser::parse(path);
+  OptimizationReport report = MeshOptimizer::optimize(vertices, indices, false);
+
+  ObjectData& obj = m_dynamicObjects[material];
+  obj.commands.emplace_back(IndirectCommand{
+    .indexCount     = static_cast<unsigned int>(indices.size()),
+    .instanceCount  = 1,
+    .firstIndex     = static_cast<unsigned int>(obj.indices.size()),
+    .vertexOffset   = static_cast<unsigned int>(obj.vertices.size()),
+    .firstInstance  = static_cast<unsigned int>(obj.commands.size())
+  });
+  obj.bounds.emplace_back(Bounds::compute(vertices));
+  obj.transforms.emplace_back(std::make_shared<Transform>(transform));
+  obj.transforms.back()->m_manager = this;
+  m_objectMaterials.emplace(obj.transforms.back().get(), material);
+  m_reports.emplace(obj.transforms.back().get(), report);
+
+  m_dynamicRanges.emplace(obj.transforms.back().get(), DynamicRange{
+    .material = material,
+    .offset   = static_cast<unsigned int>(obj.vertices.size()),
+    .count    = static_cast<unsigned int>(vertices.size())
+  });
+
+  obj.vertices.insert(obj.vertices.end(), vertices.begin(), vertices.end());
+  obj.indices.insert(obj.indices.end(), indices.begin(), indices.end());
+
   return obj.transforms.back();
 }
 
 void ObjectManager::loadTransforms() {
   unsigned int transformIndex = 0;
-  for (auto& [material, obj] : m_objects) {
-    obj.transformIndex = transformIndex;
-
-    for (const auto& t : obj.transforms) {
-      m_transforms.emplace_back(
-        mat4::translation(t->m_position) *
-        mat4::rotation(t->m_rotation) *
-        mat4::scale(t->m_scale)
-      );
-      t->m_index = transformIndex++;
+  for (auto * objects : { &m_objects, &m_dynamicObjects }) {
+    for (auto& [material, obj] : *objects) {
+      obj.transformIndex = transformIndex;
+
+      for (unsigned int i = 0; i < obj.transforms.size(); ++i) {
+        const auto& t = obj.transforms[i];
+        m_transforms.emplace_back(
+          mat4::translation(t->m_position) *
+          mat4::rotation(t->m_rotation) *
+          mat4::scale(t->m_scale)
+        );
+        m_localBounds.emplace_back(obj.bounds[i]);
+        t->m_index = transformIndex++;
+      }
     }
   }
+
+  m_worldBounds.resize(m_transforms.size());
+  for (unsigned int i = 0; i < m_transforms.size(); ++i)
+    m_worldBounds.set(i, m_localBounds[i].transformed(m_transforms[i]));
 }
 
 void ObjectManager::batch(unsigned int index, const std::tuple<vec3, vec3, vec3>& vals) {
   m_updates.insert_or_assign(index, vals);
 }
 
+void ObjectManager::batchVertices(const transform& object, unsigned int first, const std::vector<Vertex>& vertices) {
+  if (!m_dynamicRanges.contains(object.get()))
+    throw std::runtime_error("groot-engine: object is not dynamic");
+
+  const DynamicRange& range = m_dynamicRanges.at(object.get());
+  if (first + vertices.size() > range.count)
+    throw std::runtime_error("groot-engine: vertex update out of range");
+
+  ObjectData& obj = m_dynamicObjects.at(range.material);
+  unsigned int begin = range.offset + first;
+  std::copy(vertices.begin(), vertices.end(), obj.vertices.begin() + begin);
+
+  for (auto& ranges : obj.dirtyRanges)
+    ranges.emplace_back(begin, begin + vertices.size());
+
+  Bounds bounds = Bounds::compute(obj.vertices.data() + range.offset, range.count);
+  for (unsigned int i = 0; i < obj.transforms.size(); ++i) {
+    if (obj.transforms[i] == object) obj.bounds[i] = bounds;
+  }
+
+  if (object->m_index < m_localBounds.size()) {
+    m_localBounds[object->m_index] = bounds;
+    m_worldBounds.set(object->m_index, bounds.transformed(m_transforms[object->m_index]));
+  }
+
+  if (object->m_index < m_cullData.size()) {
+    m_cullData[object->m_index].sphere = vec4(bounds.center, bounds.radius);
+    m_cullData[object->m_index].boxMin = vec4(bounds.min, 1.0f);
+    m_cullData[object->m_index].boxMax = vec4(bounds.max, 1.0f);
+    ++m_cullVersion;
+  }
+
+  if (object->m_index < m_objectClusters.size()) {
+    m_clusterData[m_objectClusters[object->m_index]].sphere = vec4(bounds.center, bounds.radius);
+    ++m_cullVersion;
+  }
+}
+
 void ObjectManager::updateTransforms() {
   for (auto& [index, vals] : m_updates) {
     auto [position, rotation, scale] = vals;
     m_transforms[index] = mat4::translation(position) *
                           mat4::rotation(rotation) *
                           mat4::scale(scale);
+    m_worldBounds.set(index, m_localBounds[index].transformed(m_transforms[index]));
+  }
+  m_updates.clear();
+}
+
+void ObjectManager::updateVertices(unsigned int frameIndex) {
+  for (auto& [material, obj] : m_dynamicObjects) {
+    if (obj.dirtyRanges.empty() || obj.dirtyRanges[frameIndex].empty()) continue;
+
+    auto& ranges = obj.dirtyRanges[frameIndex];
+    std::sort(ranges.begin(), ranges.end());
+
+    char * dst = reinterpret_cast<char *>(m_dynamicMap) + m_dynamicOffsets[obj.bufferIndex * m_bufferCount + frameIndex];
+    auto flush = [this, &obj, dst](unsigned int begin, unsigned int end) {
+      Vertex::pack(m_vertexFormat, obj.vertices.data() + begin, end - begin, dst + begin * Vertex::size(m_vertexFormat));
+    };
+
+    auto [begin, end] = ranges.front();
+    for (const auto& [rangeBegin, rangeEnd] : ranges) {
+      if (rangeBegin > end) {
+        flush(begin, end);
+        begin = rangeBegin;
+      }
+      end = std::max(end, rangeEnd);
+    }
+    flush(begin, end);
+
+    ranges.clear();
   }
 }
 
 void ObjectManager::updateTimes(double time) {
-  for (auto& [material, obj] : m_objects) {
-    for (auto& transform : obj.transforms)
-      transform->m_time += time;
+  for (auto * objects : { &m_objects, &m_dynamicObjects }) {
+    for (auto& [material, obj] : *objects) {
+      for (auto& transform : obj.transforms)
+        transform->m_time += time;
+    }
   }
 }
 
-void ObjectManager::load(const Engine& engine) {
-  if (m_objects.empty()) return;
+void ObjectManager::setOccluder(const transform& object, bool occluder) {
+  if (object->m_manager != this)
+    throw std::runtime_error("groot-engine: object does not belong to this engine");
 
-  std::vector<vk::BufferCreateInfo> vertInfos;
-  std::vector<vk::BufferCreateInfo> indInfos;
-  std::vector<vk::BufferCreateInfo> indirInfos;
+  if (occluder)
+    m_occluders.insert(object.get());
+  else
+    m_occluders.erase(object.get());
+}
 
-  for (auto& [material, obj] : m_objects) {
-    obj.bufferIndex = vertInfos.size();
+void ObjectManager::cull(unsigned int frameIndex, const Frustum& frustum, WorkerPool& workers, const OcclusionBuffer * occlusion) {
+  if (m_indirectMap == nullptr) return;
 
-    vertInfos.emplace_back(vk::BufferCreateInfo{
-      .size         = obj.vertices.size() * sizeof(Vertex),
-      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
-      .sharingMode  = vk::SharingMode::eExclusive
-    });
+  const unsigned int chunkSize = 16384;
+  const unsigned int count = m_worldBounds.size();
 
-    indInfos.emplace_back(vk::BufferCreateInfo{
-      .size         = obj.indices.size() * sizeof(unsigned int),
-      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
-      .sharingMode  = vk::SharingMode::eExclusive
-    });
+  IndirectCommand * commands = reinterpret_cast<IndirectCommand *>(
+    reinterpret_cast<char *>(m_indirectMap) + m_indirectOffsets[frameIndex]
+  );
 
-    indirInfos.emplace_back(vk::BufferCreateInfo{
-      .size         = obj.commands.size() * sizeof(IndirectCommand),
-      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
-      .sharingMode  = vk::SharingMode::eExclusive
-    });
+  auto cullChunk = [this, &frustum, occlusion, commands](unsigned int first, unsigned int last) {
+    frustum.cull(m_worldBounds, first, last, m_visibility.data());
+    for (unsigned int i = first; i < last; ++i)
+      commands[i].instanceCount = m_visibility[i] && (occlusion == nullptr || occlusion->visible(m_worldBounds[i]));
+  };
+
+  workers.run((count + chunkSize - 1) / chunkSize, [&cullChunk, count](unsigned int chunk) {
+    cullChunk(chunk * chunkSize, std::min((chunk + 1) * chunkSize, count));
+  });
+
+  if (occlusion == nullptr) return;
+
+  for (const Transform * object : m_occluders) {
+    if (object->m_index < count)
+      commands[object->m_index].instanceCount = m_visibility[object->m_index];
   }
+}
 
-  auto [vertTransMem, vertTransBufs, vertTransOffs, vertTransSize] = Allocator::bufferPool(engine, vertInfos,
-    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+void ObjectManager::selectLods(unsigned int frameIndex, const mat4& viewProjection, float projectionScale) {
+  if (m_indirectMap == nullptr || m_lodLevels <= 1) return;
+
+  IndirectCommand * commands = reinterpret_cast<IndirectCommand *>(
+    reinterpret_cast<char *>(m_indirectMap) + m_indirectOffsets[frameIndex]
   );
 
-  auto [indTransMem, indTransBufs, indTransOffs, indTransSize] = Allocator::bufferPool(engine, indInfos,
-    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  const float * cx = m_worldBounds.component(CenterX);
+  const float * cy = m_worldBounds.component(CenterY);
+  const float * cz = m_worldBounds.component(CenterZ);
+  const float * r = m_worldBounds.component(Radius);
+  const vec4& w = viewProjection[3];
+
+  for (unsigned int i = 0; i < m_lods.size(); ++i) {
+    if (m_lods[i].size() <= 1) continue;
+
+    float distance = w.x * cx[i] + w.y * cy[i] + w.z * cz[i] + w.w;
+    unsigned int level = 0;
+
+    if (distance > r[i]) {
+      float size = 2.0f * r[i] * projectionScale / distance;
+      if (size < m_lodScreenSize) {
+        level = std::min(
+          static_cast<unsigned int>(std::ceil(std::log2(m_lodScreenSize / size))),
+          static_cast<unsigned int>(m_lods[i].size() - 1)
+        );
+      }
+    }
+
+    commands[i].firstIndex = m_lods[i][level].firstIndex;
+    commands[i].indexCount = m_lods[i][level].indexCount;
+  }
+}
+
+void ObjectManager::restoreOrder(unsigned int frameIndex) {
+  if (m_indirectMap == nullptr || !m_sorted[frameIndex]) return;
+
+  IndirectCommand * commands = reinterpret_cast<IndirectCommand *>(
+    reinterpret_cast<char *>(m_indirectMap) + m_indirectOffsets[frameIndex]
   );
 
-  auto [indirTransMem, indirTransBufs, indirTransOffs, indirTransSize] = Allocator::bufferPool(engine, indirInfos,
-    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  for (const auto * objects : { &m_objects, &m_dynamicObjects }) {
+    for (const auto& [material, obj] : *objects) {
+      std::vector<IndirectCommand> batch(commands + obj.transformIndex, commands + obj.transformIndex + obj.commands.size());
+      for (const IndirectCommand& command : batch)
+        commands[obj.transformIndex + command.firstInstance] = command;
+    }
+  }
+
+  m_sorted[frameIndex] = false;
+}
+
+void ObjectManager::sortBatches(unsigned int frameIndex, const mat4& viewProjection, const std::set<std::string>& transparent) {
+  if (m_indirectMap == nullptr) return;
+
+  IndirectCommand * commands = reinterpret_cast<IndirectCommand *>(
+    reinterpret_cast<char *>(m_indirectMap) + m_indirectOffsets[frameIndex]
   );
 
-  void * vertMap = vertTransMem.mapMemory(0, vertTransSize);
-  void * indMap = indTransMem.mapMemory(0, indTransSize);
-  void * indirMap = indirTransMem.mapMemory(0, indirTransSize);
+  const float * cx = m_worldBounds.component(CenterX);
+  const float * cy = m_worldBounds.component(CenterY);
+  const float * cz = m_worldBounds.component(CenterZ);
+  const vec4& w = viewProjection[3];
 
-  std::vector<std::tuple<vk::BufferCopy, vk::BufferCopy, vk::BufferCopy>> copies;
-  for (const auto& [material, obj] : m_objects) {
-    memcpy(reinterpret_cast<char *>(vertMap) + vertTransOffs[obj.bufferIndex], obj.vertices.data(), obj.vertices.size() * sizeof(Vertex));
-    memcpy(reinterpret_cast<char *>(indMap) + indTransOffs[obj.bufferIndex], obj.indices.data(), obj.indices.size() * sizeof(unsigned int));
-    memcpy(reinterpret_cast<char *>(indirMap) + indirTransOffs[obj.bufferIndex], obj.commands.data(), obj.commands.size() * sizeof(IndirectCommand));
+  std::vector<float> depths(m_worldBounds.size());
+  for (unsigned int i = 0; i < depths.size(); ++i)
+    depths[i] = w.x * cx[i] + w.y * cy[i] + w.z * cz[i] + w.w;
 
-    vertInfos[obj.bufferIndex].usage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst;
-    indInfos[obj.bufferIndex].usage = vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst;
-    indirInfos[obj.bufferIndex].usage = vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst;
+  std::map<std::string, float> keys;
+  for (const auto * objects : { &m_objects, &m_dynamicObjects }) {
+    for (const auto& [material, obj] : *objects) {
+      bool backToFront = transparent.contains(material);
+      unsigned int first = obj.transformIndex;
+      unsigned int count = obj.commands.size();
 
-    copies.emplace_back(std::tuple<vk::BufferCopy, vk::BufferCopy, vk::BufferCopy>{
-      vk::BufferCopy{ .size = obj.vertices.size() * sizeof(Vertex) },
-      vk::BufferCopy{ .size = obj.indices.size() * sizeof(unsigned int) },
-      vk::BufferCopy{ .size = obj.commands.size() * sizeof(IndirectCommand) }
-    });
+      auto key = keys.emplace(material, depths[first]).first;
+      for (unsigned int i = first; i < first + count; ++i)
+        key->second = backToFront ? std::max(key->second, depths[i]) : std::min(key->second, depths[i]);
+
+      if (!m_sortObjects || count < 2) continue;
+
+      std::vector<IndirectCommand> batch(commands + first, commands + first + count);
+      std::sort(batch.begin(), batch.end(), [&depths, first, backToFront](const IndirectCommand& a, const IndirectCommand& b) {
+        float da = depths[first + a.firstInstance];
+        float db = depths[first + b.firstInstance];
+        return backToFront ? da > db : da < db;
+      });
+
+      std::copy(batch.begin(), batch.end(), commands + first);
+    }
+  }
+
+  std::sort(m_drawOrder.begin(), m_drawOrder.end(), [&keys, &transparent](const std::string& a, const std::string& b) {
+    bool ta = transparent.contains(a);
+    bool tb = transparent.contains(b);
+    if (ta != tb) return tb;
+    return ta ? keys.at(a) > keys.at(b) : keys.at(a) < keys.at(b);
+  });
+
+  m_sorted[frameIndex] = m_sortObjects;
+}
+
+void ObjectManager::load(const Engine& engine, WorkerPool& workers) {
+  m_bufferCount = engine.m_settings.buffer_mode;
+  m_vertexFormat = engine.m_settings.vertex_format;
+  m_lodLevels = engine.m_settings.lod_levels;
+  m_lodScreenSize = engine.m_settings.lod_screen_size;
+  m_clusterCulling = engine.m_settings.culling_mode == ClusterCulling;
+  m_sortObjects = engine.m_settings.culling_mode == NoCulling ||
+                  engine.m_settings.culling_mode == CPUCulling ||
+                  engine.m_settings.culling_mode == SoftwareOcclusionCulling;
+  m_sorted.assign(m_bufferCount, false);
+
+  loadMeshlets(workers);
+  loadLods(workers);
+  loadStatic(engine);
+  loadDynamic(engine);
+  loadCommands(engine);
+}
+
+void ObjectManager::loadMeshlets(WorkerPool& workers) {
+  if (!m_clusterCulling) return;
+
+  std::vector<std::pair<ObjectData *, unsigned int>> jobs;
+  for (auto& [material, obj] : m_objects) {
+    obj.meshlets.clear();
+    for (unsigned int i = 0; i < obj.commands.size(); ++i)
+      jobs.emplace_back(&obj, i);
+  }
+
+  std::vector<std::pair<std::vector<Meshlet>, std::vector<unsigned int>>> builds(jobs.size());
+  workers.run(jobs.size(), [&jobs, &builds](unsigned int job) {
+    const auto& [obj, i] = jobs[job];
+    const IndirectCommand& command = obj->commands[i];
+    unsigned int vertexEnd = i + 1 < obj->commands.size() ? obj->commands[i + 1].vertexOffset : static_cast<unsigned int>(obj->vertices.size());
+
+    builds[job] = MeshletBuilder::build(
+      obj->vertices.data() + command.vertexOffset,
+      vertexEnd - command.vertexOffset,
+      obj->indices.data() + command.firstIndex,
+      command.indexCount
+    );
+  });
+
+  for (unsigned int job = 0; job < jobs.size(); ++job) {
+    auto& [obj, i] = jobs[job];
+    auto& [meshlets, indices] = builds[job];
+
+    std::copy(indices.begin(), indices.end(), obj->indices.begin() + obj->commands[i].firstIndex);
+    for (auto& meshlet : meshlets)
+      meshlet.firstIndex += obj->commands[i].firstIndex;
+
+    obj->meshlets.emplace_back(std::move(meshlets));
+  }
+}
+
+void ObjectManager::loadLods(WorkerPool& workers) {
+  std::vector<std::pair<ObjectData *, unsigned int>> jobs;
+  for (auto& [material, obj] : m_objects) {
+    obj.lods.clear();
+    for (unsigned int i = 0; i < obj.commands.size(); ++i) {
+      obj.lods.emplace_back(std::vector<LodRange>{ LodRange{ obj.commands[i].firstIndex, obj.commands[i].indexCount } });
+      if (m_lodLevels > 1) jobs.emplace_back(&obj, i);
+    }
+  }
+
+  std::vector<std::vector<std::vector<unsigned int>>> chains(jobs.size());
+  workers.run(jobs.size(), [&jobs, &chains, levels = m_lodLevels](unsigned int job) {
+    const auto& [obj, i] = jobs[job];
+    const IndirectCommand& command = obj->commands[i];
+    unsigned int vertexEnd = i + 1 < obj->commands.size() ? obj->commands[i + 1].vertexOffset : static_cast<unsigned int>(obj->vertices.size());
+
+    chains[job] = MeshSimplifier::lods(
+      obj->vertices.data() + command.vertexOffset,
+      vertexEnd - command.vertexOffset,
+      obj->indices.data() + command.firstIndex,
+      command.indexCount,
+      levels
+    );
+  });
+
+  for (unsigned int job = 0; job < jobs.size(); ++job) {
+    auto& [obj, i] = jobs[job];
+    for (const auto& indices : chains[job]) {
+      obj->lods[i].emplace_back(LodRange{
+        .firstIndex = static_cast<unsigned int>(obj->indices.size()),
+        .indexCount = static_cast<unsigned int>(indices.size())
+      });
+      obj->indices.insert(obj->indices.end(), indices.begin(), indices.end());
+    }
   }
+}
+
+void ObjectManager::loadStatic(const Engine& engine) {
+  if (m_objects.empty()) return;
+
+  std::vector<std::vector<char>> packedVertices;
+  std::vector<std::vector<char>> packedIndices;
+
+  std::vector<std::pair<const void *, unsigned int>> vertData;
+  std::vector<std::pair<const void *, unsigned int>> indData;
+
+  for (auto& [material, obj] : m_objects) {
+    obj.bufferIndex = vertData.size();
 
-  vertTransMem.unmapMemory();
-  indTransMem.unmapMemory();
-  indirTransMem.unmapMemory();
-  vertMap = indMap = indirMap = nullptr;
+    packedVertices.emplace_back(Vertex::pack(m_vertexFormat, obj.vertices));
+    packedIndices.emplace_back(packIndices(obj));
 
-  auto [tmp_vertMem, tmp_vertBufs, _v1, _v2] = Allocator::bufferPool(engine, vertInfos,
-    vk::MemoryPropertyFlagBits::eDeviceLocal
+    vertData.emplace_back(packedVertices.back().data(), packedVertices.back().size());
+    indData.emplace_back(packedIndices.back().data(), packedIndices.back().size());
+  }
+
+  auto [tmp_vertMem, tmp_vertBufs] = upload(engine, vertData,
+    vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer
   );
   m_vertexMemory = std::move(tmp_vertMem);
   m_vertexBuffers = std::move(tmp_vertBufs);
 
-  auto [tmp_indMem, tmp_indBufs, _i1, _i2] = Allocator::bufferPool(engine, indInfos,
-    vk::MemoryPropertyFlagBits::eDeviceLocal
-  );
+  auto [tmp_indMem, tmp_indBufs] = upload(engine, indData, vk::BufferUsageFlagBits::eIndexBuffer);
   m_indexMemory = std::move(tmp_indMem);
   m_indexBuffers = std::move(tmp_indBufs);
+}
+
+void ObjectManager::loadDynamic(const Engine& engine) {
+  if (m_dynamicObjects.empty()) return;
+
+  std::vector<std::vector<char>> packedIndices;
+
+  std::vector<vk::BufferCreateInfo> vertInfos;
+  std::vector<std::pair<const void *, unsigned int>> indData;
+
+  for (auto& [material, obj] : m_dynamicObjects) {
+    obj.bufferIndex = indData.size();
+    obj.dirtyRanges.resize(m_bufferCount);
+
+    for (unsigned int i = 0; i < m_bufferCount; ++i) {
+      vertInfos.emplace_back(vk::BufferCreateInfo{
+        .size         = obj.vertices.size() * Vertex::size(m_vertexFormat),
+        .usage        = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer,
+        .sharingMode  = vk::SharingMode::eExclusive
+      });
+    }
+
+    packedIndices.emplace_back(packIndices(obj));
+    indData.emplace_back(packedIndices.back().data(), packedIndices.back().size());
+  }
+
+  auto [tmp_dynMem, tmp_dynBufs, tmp_dynOffs, dynSize] = Allocator::bufferPool(engine, vertInfos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+  m_dynamicMemory = std::move(tmp_dynMem);
+  m_dynamicBuffers = std::move(tmp_dynBufs);
+  m_dynamicOffsets = std::move(tmp_dynOffs);
+
+  m_dynamicMap = m_dynamicMemory.mapMemory(0, dynSize);
+  for (const auto& [material, obj] : m_dynamicObjects) {
+    for (unsigned int i = 0; i < m_bufferCount; ++i) {
+      Vertex::pack(
+        m_vertexFormat,
+        obj.vertices.data(),
+        obj.vertices.size(),
+        reinterpret_cast<char *>(m_dynamicMap) + m_dynamicOffsets[obj.bufferIndex * m_bufferCount + i]
+      );
+    }
+  }
+
+  auto [tmp_indMem, tmp_indBufs] = upload(engine, indData, vk::BufferUsageFlagBits::eIndexBuffer);
+  m_dynamicIndexMemory = std::move(tmp_indMem);
+  m_dynamicIndexBuffers = std::move(tmp_indBufs);
+}
+
+void ObjectManager::loadCommands(const Engine& engine) {
+  std::vector<IndirectCommand> commands;
+  for (auto * objects : { &m_objects, &m_dynamicObjects }) {
+    for (auto& [material, obj] : *objects) {
+      obj.batchIndex = m_batchCount++;
+      if (std::find(m_drawOrder.begin(), m_drawOrder.end(), material) == m_drawOrder.end())
+        m_drawOrder.emplace_back(material);
+      commands.insert(commands.end(), obj.commands.begin(), obj.commands.end());
+
+      for (unsigned int i = 0; i < obj.commands.size(); ++i) {
+        if (i < obj.lods.size())
+          m_lods.emplace_back(obj.lods[i]);
+        else
+          m_lods.emplace_back(std::vector<LodRange>{ LodRange{ obj.commands[i].firstIndex, obj.commands[i].indexCount } });
+      }
+
+      if (m_clusterCulling) {
+        unsigned int first = m_clusterData.size();
+
+        for (unsigned int i = 0; i < obj.commands.size(); ++i) {
+          m_objectClusters.emplace_back(m_clusterData.size());
+
+          if (i < obj.meshlets.size()) {
+            for (const auto& meshlet : obj.meshlets[i]) {
+              m_clusterData.emplace_back(ClusterData{
+                .sphere     = vec4(meshlet.bounds.center, meshlet.bounds.radius),
+                .cone       = vec4(meshlet.coneAxis, meshlet.coneCutoff),
+                .object     = obj.transformIndex + i,
+                .batch      = obj.batchIndex,
+                .first      = first,
+                .firstIndex = meshlet.firstIndex,
+                .indexCount = meshlet.indexCount
+              });
+            }
+          }
+          else {
+            m_clusterData.emplace_back(ClusterData{
+              .sphere     = vec4(obj.bounds[i].center, obj.bounds[i].radius),
+              .object     = obj.transformIndex + i,
+              .batch      = obj.batchIndex,
+              .first      = first,
+              .firstIndex = obj.commands[i].firstIndex,
+              .indexCount = obj.commands[i].indexCount
+            });
+          }
+        }
+
+        m_batchClusters.emplace_back(first, m_clusterData.size() - first);
+      }
+
+      for (const auto& bounds : obj.bounds) {
+        m_cullData.emplace_back(CullData{
+          .sphere = vec4(bounds.center, bounds.radius),
+          .boxMin = vec4(bounds.min, 1.0f),
+          .boxMax = vec4(bounds.max, 1.0f),
+          .batch  = obj.batchIndex,
+          .first  = obj.transformIndex
+        });
+      }
+    }
+  }
+
+  if (commands.empty()) return;
+
+  m_visibility.assign(commands.size(), 1);
+
+  std::vector<vk::BufferCreateInfo> indirInfos;
+  for (unsigned int i = 0; i < m_bufferCount; ++i) {
+    indirInfos.emplace_back(vk::BufferCreateInfo{
+      .size         = commands.size() * sizeof(IndirectCommand),
+      .usage        = vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eStorageBuffer,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+  }
 
-  auto [tmp_indirMem, tmp_indirBufs, _in1, _in2] = Allocator::bufferPool(engine, indirInfos,
-    vk::MemoryPropertyFlagBits::eDeviceLocal
+  auto [tmp_indirMem, tmp_indirBufs, tmp_indirOffs, indirSize] = Allocator::bufferPool(engine, indirInfos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
   );
   m_indirectMemory = std::move(tmp_indirMem);
   m_indirectBuffers = std::move(tmp_indirBufs);
+  m_indirectOffsets = std::move(tmp_indirOffs);
+
+  m_indirectMap = m_indirectMemory.mapMemory(0, indirSize);
+  for (unsigned int i = 0; i < m_bufferCount; ++i) {
+    memcpy(
+      reinterpret_cast<char *>(m_indirectMap) + m_indirectOffsets[i],
+      commands.data(),
+      commands.size() * sizeof(IndirectCommand)
+    );
+  }
+}
+
+void ObjectManager::loadVertexSets(const Engine& engine, const vk::raii::DescriptorSetLayout& setLayout) {
+  unsigned int count = m_vertexBuffers.size() + m_dynamicBuffers.size();
+  if (count == 0) return;
+
+  auto [tmp_setPool, tmp_sets] = Allocator::descriptorPool(engine, setLayout, count);
+  m_vertexSetPool = std::move(tmp_setPool);
+  m_vertexSets = std::move(tmp_sets);
+
+  std::vector<vk::DescriptorBufferInfo> infos;
+  for (const auto * buffers : { &m_vertexBuffers, &m_dynamicBuffers }) {
+    for (const auto& buffer : *buffers)
+      infos.emplace_back(vk::DescriptorBufferInfo{ .buffer = buffer, .range = vk::WholeSize });
+  }
+
+  std::vector<vk::WriteDescriptorSet> writes;
+  for (unsigned int i = 0; i < count; ++i) {
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = m_vertexSets[i],
+      .dstBinding       = 0,
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .pBufferInfo      = &infos[i]
+    });
+  }
+
+  engine.m_context.device().updateDescriptorSets(writes, nullptr);
+}
+
+std::vector<char> ObjectManager::packIndices(ObjectData& obj) {
+  unsigned int maxIndex = obj.indices.empty() ? 0 : *std::max_element(obj.indices.begin(), obj.indices.end());
+
+  if (maxIndex > std::numeric_limits<unsigned short>::max()) {
+    obj.indexType = vk::IndexType::eUint32;
+
+    std::vector<char> buffer(obj.indices.size() * sizeof(unsigned int));
+    memcpy(buffer.data(), obj.indices.data(), buffer.size());
+    return buffer;
+  }
+
+  obj.indexType = vk::IndexType::eUint16;
+
+  std::vector<char> buffer(obj.indices.size() * sizeof(unsigned short));
+  unsigned short * dst = reinterpret_cast<unsigned short *>(buffer.data());
+  for (unsigned int i = 0; i < obj.indices.size(); ++i)
+    dst[i] = static_cast<unsigned short>(obj.indices[i]);
+
+  return buffer;
+}
+
+ObjectManager::Upload ObjectManager::upload(
+  const Engine& engine,
+  const std::vector<std::pair<const void *, unsigned int>>& data,
+  vk::BufferUsageFlags usage
+) const {
+  std::vector<vk::BufferCreateInfo> infos;
+  for (const auto& [src, size] : data) {
+    infos.emplace_back(vk::BufferCreateInfo{
+      .size         = size,
+      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+  }
+
+  auto [transMem, transBufs, transOffs, transSize] = Allocator::bufferPool(engine, infos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+
+  void * map = transMem.mapMemory(0, transSize);
+  for (unsigned int i = 0; i < data.size(); ++i) {
+    memcpy(reinterpret_cast<char *>(map) + transOffs[i], data[i].first, data[i].second);
+    infos[i].usage = usage | vk::BufferUsageFlagBits::eTransferDst;
+  }
+  transMem.unmapMemory();
+  map = nullptr;
+
+  auto [memory, buffers, _o, _s] = Allocator::bufferPool(engine, infos, vk::MemoryPropertyFlagBits::eDeviceLocal);
 
   vk::raii::CommandBuffer transferCmd = std::move(engine.getCmds(QueueFamilyType::Transfer, 1)[0]);
   transferCmd.begin({ .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
 
-  unsigned int index = 0;
-  for (const auto& [vertCopy, indCopy, indirCopy] : copies) {
-    transferCmd.copyBuffer(vertTransBufs[index], m_vertexBuffers[index], vertCopy);
-    transferCmd.copyBuffer(indTransBufs[index], m_indexBuffers[index], indCopy);
-    transferCmd.copyBuffer(indirTransBufs[index], m_indirectBuffers[index], indirCopy);
-    ++index;
-  }
+  for (unsigned int i = 0; i < data.size(); ++i)
+    transferCmd.copyBuffer(transBufs[i], buffers[i], vk::BufferCopy{ .size = data[i].second });
 
   transferCmd.end();
 
@@ -193,6 +799,8 @@ void ObjectManager::load(const Engine& engine) {
 
   if (engine.m_context.device().waitForFences(*transferFence, true, ge_timeout) != vk::Result::eSuccess)
     throw std::runtime_error("groot-engine: hung waiting for objects buffer transfer");
+
+  return { std::move(memory), std::move(buffers) };
 }
 
-} // namespace ge
\ No newline at end of file
+} // namespace ge
@@ -0,0 +1,286 @@
+#include "src/include/occlusion.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+#elif defined(__ARM_NEON)
+  #include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace ge {
+
+static constexpr unsigned int tileWidth = 8;
+static constexpr unsigned int tileHeight = 4;
+static constexpr unsigned int tileSize = tileWidth * tileHeight;
+
+OcclusionBuffer::OcclusionBuffer(unsigned int width, unsigned int height) {
+  resize(width, height);
+}
+
+unsigned int OcclusionBuffer::width() const {
+  return m_width;
+}
+
+unsigned int OcclusionBuffer::height() const {
+  return m_height;
+}
+
+float OcclusionBuffer::depth(unsigned int x, unsigned int y) const {
+  return m_depth[index(x, y)];
+}
+
+void OcclusionBuffer::resize(unsigned int width, unsigned int height) {
+  m_tilesX = (width + tileWidth - 1) / tileWidth;
+  m_tilesY = (height + tileHeight - 1) / tileHeight;
+  m_width = m_tilesX * tileWidth;
+  m_height = m_tilesY * tileHeight;
+
+  m_depth.assign(m_width * m_height, 1.0f);
+  m_tileDepth.assign(m_tilesX * m_tilesY, 1.0f);
+}
+
+void OcclusionBuffer::render(const mat4& viewProjection, const std::vector<Occluder>& occluders, WorkerPool& workers) {
+  m_viewProjection = viewProjection;
+  std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+  std::fill(m_tileDepth.begin(), m_tileDepth.end(), 1.0f);
+
+  if (m_depth.empty() || occluders.empty()) return;
+
+  const unsigned int setupCount = std::min<unsigned int>(workers.size(), occluders.size());
+  std::vector<std::vector<Triangle>> setups(setupCount);
+  workers.run(setupCount, [this, &occluders, &setups, setupCount](unsigned int i) {
+    for (unsigned int j = i; j < occluders.size(); j += setupCount)
+      setup(occluders[j], setups[i]);
+  });
+
+  std::vector<Triangle> triangles;
+  for (const auto& part : setups)
+    triangles.insert(triangles.end(), part.begin(), part.end());
+
+  if (triangles.empty()) return;
+
+  const unsigned int bands = std::min(workers.size(), m_tilesY);
+  workers.run(bands, [this, &triangles, bands](unsigned int band) {
+    rasterize(triangles, band * m_tilesY / bands, (band + 1) * m_tilesY / bands);
+  });
+}
+
+bool OcclusionBuffer::visible(const Bounds& bounds) const {
+  if (m_depth.empty()) return true;
+
+  float minX = std::numeric_limits<float>::max();
+  float minY = std::numeric_limits<float>::max();
+  float maxX = std::numeric_limits<float>::lowest();
+  float maxY = std::numeric_limits<float>::lowest();
+  float nearest = 1.0f;
+
+  for (unsigned int i = 0; i < 8; ++i) {
+    vec4 clip = m_viewProjection * vec4(
+      (i & 1) ? bounds.max.x : bounds.min.x,
+      (i & 2) ? bounds.max.y : bounds.min.y,
+      (i & 4) ? bounds.max.z : bounds.min.z,
+      1.0f
+    );
+
+    if (clip.z < 0.0f || clip.w <= 0.0f) return true;
+
+    float x = (clip.x / clip.w * 0.5f + 0.5f) * m_width;
+    float y = (clip.y / clip.w * 0.5f + 0.5f) * m_height;
+    minX = std::min(minX, x);
+    maxX = std::max(maxX, x);
+    minY = std::min(minY, y);
+    maxY = std::max(maxY, y);
+    nearest = std::min(nearest, clip.z / clip.w);
+  }
+
+  int x0 = static_cast<int>(std::floor(std::clamp(minX, -1.0f, static_cast<float>(m_width))));
+  int x1 = static_cast<int>(std::floor(std::clamp(maxX, -1.0f, static_cast<float>(m_width))));
+  int y0 = static_cast<int>(std::floor(std::clamp(minY, -1.0f, static_cast<float>(m_height))));
+  int y1 = static_cast<int>(std::floor(std::clamp(maxY, -1.0f, static_cast<float>(m_height))));
+
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, static_cast<int>(m_width) - 1);
+  y1 = std::min(y1, static_cast<int>(m_height) - 1);
+  if (x0 > x1 || y0 > y1) return true;
+
+  for (int ty = y0 / static_cast<int>(tileHeight); ty <= y1 / static_cast<int>(tileHeight); ++ty) {
+    for (int tx = x0 / static_cast<int>(tileWidth); tx <= x1 / static_cast<int>(tileWidth); ++tx) {
+      if (m_tileDepth[ty * m_tilesX + tx] < nearest) continue;
+
+      int rowBegin = std::max(y0, ty * static_cast<int>(tileHeight));
+      int rowEnd = std::min(y1, (ty + 1) * static_cast<int>(tileHeight) - 1);
+      int columnBegin = std::max(x0, tx * static_cast<int>(tileWidth));
+      int columnEnd = std::min(x1, (tx + 1) * static_cast<int>(tileWidth) - 1);
+
+      for (int y = rowBegin; y <= rowEnd; ++y) {
+        for (int x = columnBegin; x <= columnEnd; ++x) {
+          if (m_depth[index(x, y)] >= nearest) return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+unsigned int OcclusionBuffer::index(unsigned int x, unsigned int y) const {
+  return ((y / tileHeight) * m_tilesX + x / tileWidth) * tileSize + (y % tileHeight) * tileWidth + x % tileWidth;
+}
+
+void OcclusionBuffer::setup(const Occluder& occluder, std::vector<Triangle>& triangles) const {
+  mat4 transform = m_viewProjection * occluder.transform;
+
+  for (unsigned int i = 0; i + 2 < occluder.indexCount; i += 3) {
+    std::array<vec4, 3> clip = {
+      transform * vec4(occluder.vertices[occluder.indices[i]].m_position, 1.0f),
+      transform * vec4(occluder.vertices[occluder.indices[i + 1]].m_position, 1.0f),
+      transform * vec4(occluder.vertices[occluder.indices[i + 2]].m_position, 1.0f)
+    };
+
+    std::array<vec4, 4> polygon = { vec4(0.0f), vec4(0.0f), vec4(0.0f), vec4(0.0f) };
+    unsigned int count = 0;
+
+    for (unsigned int k = 0; k < 3; ++k) {
+      const vec4& a = clip[k];
+      const vec4& b = clip[(k + 1) % 3];
+
+      if (a.z >= 0.0f) polygon[count++] = a;
+      if ((a.z >= 0.0f) != (b.z >= 0.0f)) polygon[count++] = a + (b - a) * (a.z / (a.z - b.z));
+    }
+
+    for (unsigned int k = 1; k + 1 < count; ++k)
+      addTriangle(polygon[0], polygon[k], polygon[k + 1], triangles);
+  }
+}
+
+void OcclusionBuffer::addTriangle(const vec4& a, const vec4& b, const vec4& c, std::vector<Triangle>& triangles) const {
+  auto screen = [this](const vec4& v) {
+    return vec3(
+      (v.x / v.w * 0.5f + 0.5f) * m_width,
+      (v.y / v.w * 0.5f + 0.5f) * m_height,
+      std::clamp(v.z / v.w, 0.0f, 1.0f)
+    );
+  };
+
+  vec3 v0 = screen(a);
+  vec3 v1 = screen(b);
+  vec3 v2 = screen(c);
+
+  float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+  if (!(std::abs(area) > 1e-6f)) return;
+
+  if (area < 0.0f) {
+    std::swap(v1, v2);
+    area = -area;
+  }
+
+  auto pixel = [](float value, float limit) {
+    return std::clamp(value - 0.5f, -1.0f, limit);
+  };
+
+  Triangle triangle;
+  triangle.minX = std::max(static_cast<int>(std::ceil(pixel(std::min({ v0.x, v1.x, v2.x }), m_width))), 0);
+  triangle.maxX = std::min(static_cast<int>(std::floor(pixel(std::max({ v0.x, v1.x, v2.x }), m_width))), static_cast<int>(m_width) - 1);
+  triangle.minY = std::max(static_cast<int>(std::ceil(pixel(std::min({ v0.y, v1.y, v2.y }), m_height))), 0);
+  triangle.maxY = std::min(static_cast<int>(std::floor(pixel(std::max({ v0.y, v1.y, v2.y }), m_height))), static_cast<int>(m_height) - 1);
+  if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) return;
+
+  const vec3 * vertices[3] = { &v0, &v1, &v2 };
+  for (unsigned int k = 0; k < 3; ++k) {
+    const vec3& p = *vertices[(k + 1) % 3];
+    const vec3& q = *vertices[(k + 2) % 3];
+
+    triangle.edges[k][0] = p.y - q.y;
+    triangle.edges[k][1] = q.x - p.x;
+    triangle.edges[k][2] = p.x * q.y - p.y * q.x;
+  }
+
+  for (unsigned int j = 0; j < 3; ++j) {
+    triangle.depth[j] = (
+      triangle.edges[0][j] * v0.z +
+      triangle.edges[1][j] * v1.z +
+      triangle.edges[2][j] * v2.z
+    ) / area;
+  }
+
+  triangles.emplace_back(triangle);
+}
+
+void OcclusionBuffer::rasterize(const std::vector<Triangle>& triangles, unsigned int firstTile, unsigned int lastTile) {
+  const int firstRow = firstTile * tileHeight;
+  const int lastRow = lastTile * tileHeight - 1;
+
+  for (const auto& tri : triangles) {
+    int y0 = std::max(tri.minY, firstRow);
+    int y1 = std::min(tri.maxY, lastRow);
+    int x0 = tri.minX & ~3;
+
+    for (int y = y0; y <= y1; ++y) {
+      float py = y + 0.5f;
+      float e0 = tri.edges[0][1] * py + tri.edges[0][2];
+      float e1 = tri.edges[1][1] * py + tri.edges[1][2];
+      float e2 = tri.edges[2][1] * py + tri.edges[2][2];
+      float ez = tri.depth[1] * py + tri.depth[2];
+
+      for (int x = x0; x <= tri.maxX; x += 4) {
+        float * dst = m_depth.data() + index(x, y);
+        float px = x + 0.5f;
+
+#if defined(__x86_64__) || defined(__i386__)
+        __m128 pxs = _mm_add_ps(_mm_set1_ps(px), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+        __m128 zero = _mm_setzero_ps();
+        __m128 inside = _mm_and_ps(
+          _mm_and_ps(
+            _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(pxs, _mm_set1_ps(tri.edges[0][0])), _mm_set1_ps(e0)), zero),
+            _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(pxs, _mm_set1_ps(tri.edges[1][0])), _mm_set1_ps(e1)), zero)
+          ),
+          _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(pxs, _mm_set1_ps(tri.edges[2][0])), _mm_set1_ps(e2)), zero)
+        );
+
+        __m128 depth = _mm_add_ps(_mm_mul_ps(pxs, _mm_set1_ps(tri.depth[0])), _mm_set1_ps(ez));
+        __m128 current = _mm_loadu_ps(dst);
+        __m128 nearest = _mm_min_ps(current, _mm_max_ps(depth, zero));
+        _mm_storeu_ps(dst, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+#elif defined(__ARM_NEON)
+        const float offsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+        float32x4_t pxs = vaddq_f32(vdupq_n_f32(px), vld1q_f32(offsets));
+        float32x4_t zero = vdupq_n_f32(0.0f);
+        uint32x4_t inside = vandq_u32(
+          vandq_u32(
+            vcgeq_f32(vmlaq_n_f32(vdupq_n_f32(e0), pxs, tri.edges[0][0]), zero),
+            vcgeq_f32(vmlaq_n_f32(vdupq_n_f32(e1), pxs, tri.edges[1][0]), zero)
+          ),
+          vcgeq_f32(vmlaq_n_f32(vdupq_n_f32(e2), pxs, tri.edges[2][0]), zero)
+        );
+
+        float32x4_t depth = vmlaq_n_f32(vdupq_n_f32(ez), pxs, tri.depth[0]);
+        float32x4_t current = vld1q_f32(dst);
+        float32x4_t nearest = vminq_f32(current, vmaxq_f32(depth, zero));
+        vst1q_f32(dst, vbslq_f32(inside, nearest, current));
+#else
+        for (unsigned int lane = 0; lane < 4; ++lane) {
+          float p = px + lane;
+          bool inside = tri.edges[0][0] * p + e0 >= 0.0f &&
+                        tri.edges[1][0] * p + e1 >= 0.0f &&
+                        tri.edges[2][0] * p + e2 >= 0.0f;
+          if (inside) dst[lane] = std::min(dst[lane], std::max(tri.depth[0] * p + ez, 0.0f));
+        }
+#endif
+      }
+    }
+  }
+
+  for (unsigned int ty = firstTile; ty < lastTile; ++ty) {
+    for (unsigned int tx = 0; tx < m_tilesX; ++tx) {
+      const float * tile = m_depth.data() + (ty * m_tilesX + tx) * tileSize;
+      m_tileDepth[ty * m_tilesX + tx] = *std::max_element(tile, tile + tileSize);
+    }
+  }
+}
+
+} // namespace ge
@@ -0,0 +1,264 @@
+#include "src/include/optimizer.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace ge {
+
+float MeshOptimizer::acmr(const std::vector<unsigned int>& indices, unsigned int vertexCount, unsigned int cacheSize) {
+  if (indices.size() < 3) return 0.0f;
+
+  std::vector<unsigned int> timestamps(vertexCount, 0);
+  unsigned int time = cacheSize + 1;
+  unsigned int misses = 0;
+
+  for (unsigned int index : indices) {
+    if (time - timestamps[index] > cacheSize) {
+      timestamps[index] = time++;
+      ++misses;
+    }
+  }
+
+  return static_cast<float>(misses) / (indices.size() / 3);
+}
+
+MeshOptimizer::Output MeshOptimizer::optimizeVertexCache(
+  const std::vector<unsigned int>& indices,
+  unsigned int vertexCount,
+  unsigned int cacheSize
+) {
+  unsigned int triangleCount = indices.size() / 3;
+  if (triangleCount == 0) return indices;
+
+  std::vector<unsigned int> offsets(vertexCount + 1, 0);
+  for (unsigned int i = 0; i < triangleCount * 3; ++i)
+    ++offsets[indices[i] + 1];
+  for (unsigned int v = 0; v < vertexCount; ++v)
+    offsets[v + 1] += offsets[v];
+
+  std::vector<unsigned int> live(vertexCount, 0);
+  std::vector<unsigned int> adjacency(triangleCount * 3);
+  std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+  for (unsigned int t = 0; t < triangleCount; ++t) {
+    for (unsigned int k = 0; k < 3; ++k) {
+      unsigned int v = indices[t * 3 + k];
+      adjacency[cursor[v]++] = t;
+      ++live[v];
+    }
+  }
+
+  std::vector<unsigned int> timestamps(vertexCount, 0);
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<unsigned int> deadEnd;
+  std::vector<unsigned int> candidates;
+
+  Output output;
+  output.reserve(triangleCount * 3);
+
+  unsigned int time = cacheSize + 1;
+  unsigned int scan = 0;
+  int fan = indices[0];
+
+  while (fan >= 0) {
+    candidates.clear();
+
+    for (unsigned int a = offsets[fan]; a < offsets[fan + 1]; ++a) {
+      unsigned int t = adjacency[a];
+      if (emitted[t]) continue;
+
+      for (unsigned int k = 0; k < 3; ++k) {
+        unsigned int v = indices[t * 3 + k];
+        output.emplace_back(v);
+        deadEnd.emplace_back(v);
+        candidates.emplace_back(v);
+        --live[v];
+
+        if (time - timestamps[v] > cacheSize)
+          timestamps[v] = time++;
+      }
+
+      emitted[t] = true;
+    }
+
+    fan = -1;
+    int best = -1;
+    for (unsigned int v : candidates) {
+      if (live[v] == 0) continue;
+
+      int priority = 0;
+      if (time - timestamps[v] + 2 * live[v] <= cacheSize)
+        priority = time - timestamps[v];
+
+      if (priority > best) {
+        best = priority;
+        fan = v;
+      }
+    }
+
+    while (fan < 0 && !deadEnd.empty()) {
+      unsigned int v = deadEnd.back();
+      deadEnd.pop_back();
+      if (live[v] > 0) fan = v;
+    }
+
+    while (fan < 0 && scan < vertexCount) {
+      if (live[scan] > 0) fan = scan;
+      ++scan;
+    }
+  }
+
+  return output;
+}
+
+MeshOptimizer::Output MeshOptimizer::optimizeOverdraw(
+  const std::vector<Vertex>& vertices,
+  const std::vector<unsigned int>& indices,
+  float threshold,
+  unsigned int cacheSize
+) {
+  unsigned int triangleCount = indices.size() / 3;
+  if (triangleCount == 0) return indices;
+
+  std::vector<unsigned int> bounds = clusters(indices, vertices.size(), threshold, cacheSize);
+
+  vec3 meshCenter(0.0f);
+  float meshArea = 0.0f;
+  std::vector<vec3> centers;
+  std::vector<vec3> normals;
+
+  for (unsigned int c = 0; c + 1 < bounds.size(); ++c) {
+    vec3 center(0.0f);
+    vec3 normal(0.0f);
+    float clusterArea = 0.0f;
+
+    for (unsigned int t = bounds[c]; t < bounds[c + 1]; ++t) {
+      const vec3& a = vertices[indices[t * 3]].m_position;
+      const vec3& b = vertices[indices[t * 3 + 1]].m_position;
+      const vec3& p = vertices[indices[t * 3 + 2]].m_position;
+
+      vec3 n = (b - a).cross(p - a);
+      float area = n.magnitude();
+
+      center += (a + b + p) * (area / 3.0f);
+      normal += n;
+      clusterArea += area;
+    }
+
+    meshCenter += center;
+    meshArea += clusterArea;
+
+    centers.emplace_back(clusterArea > 0.0f ? center / clusterArea : vertices[indices[bounds[c] * 3]].m_position);
+    normals.emplace_back(normal.magnitude() > 0.0f ? normal.normalized() : vec3(0.0f));
+  }
+
+  if (meshArea > 0.0f)
+    meshCenter /= meshArea;
+
+  std::vector<float> keys;
+  for (unsigned int c = 0; c < centers.size(); ++c)
+    keys.emplace_back((centers[c] - meshCenter) * normals[c]);
+
+  std::vector<unsigned int> order(centers.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&keys](unsigned int a, unsigned int b) { return keys[a] > keys[b]; });
+
+  Output output;
+  output.reserve(indices.size());
+  for (unsigned int c : order)
+    output.insert(output.end(), indices.begin() + bounds[c] * 3, indices.begin() + bounds[c + 1] * 3);
+
+  return output;
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+  constexpr unsigned int unused = ~0u;
+
+  std::vector<unsigned int> remap(vertices.size(), unused);
+  std::vector<Vertex> reordered;
+  reordered.reserve(vertices.size());
+
+  for (unsigned int& index : indices) {
+    if (remap[index] == unused) {
+      remap[index] = reordered.size();
+      reordered.emplace_back(vertices[index]);
+    }
+    index = remap[index];
+  }
+
+  for (unsigned int v = 0; v < vertices.size(); ++v) {
+    if (remap[v] == unused)
+      reordered.emplace_back(vertices[v]);
+  }
+
+  vertices = std::move(reordered);
+}
+
+OptimizationReport MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, bool reorderVertices) {
+  OptimizationReport report{ .acmrBefore = acmr(indices, vertices.size()) };
+
+  std::vector<unsigned int> optimized = optimizeOverdraw(vertices, optimizeVertexCache(indices, vertices.size()));
+  if (acmr(optimized, vertices.size()) <= report.acmrBefore)
+    indices = std::move(optimized);
+
+  if (reorderVertices)
+    optimizeVertexFetch(vertices, indices);
+
+  report.acmrAfter = acmr(indices, vertices.size());
+  return report;
+}
+
+std::vector<unsigned int> MeshOptimizer::clusters(
+  const std::vector<unsigned int>& indices,
+  unsigned int vertexCount,
+  float threshold,
+  unsigned int cacheSize
+) {
+  unsigned int triangleCount = indices.size() / 3;
+  float target = acmr(indices, vertexCount, cacheSize) * threshold;
+
+  std::vector<unsigned int> timestamps(vertexCount, 0);
+  unsigned int time = cacheSize + 1;
+
+  auto misses = [&](unsigned int t) {
+    unsigned int count = 0;
+    for (unsigned int k = 0; k < 3; ++k) {
+      unsigned int v = indices[t * 3 + k];
+      if (time - timestamps[v] > cacheSize) {
+        timestamps[v] = time++;
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  std::vector<unsigned int> hard = { 0 };
+  for (unsigned int t = 0; t < triangleCount; ++t) {
+    if (misses(t) == 3 && t > 0) hard.emplace_back(t);
+  }
+  hard.emplace_back(triangleCount);
+
+  std::vector<unsigned int> bounds = { 0 };
+  for (unsigned int h = 0; h + 1 < hard.size(); ++h) {
+    unsigned int start = hard[h];
+    unsigned int total = 0;
+    time += cacheSize + 1;
+
+    for (unsigned int t = hard[h]; t < hard[h + 1]; ++t) {
+      total += misses(t);
+
+      if (t + 1 < hard[h + 1] && static_cast<float>(total) / (t + 1 - start) <= target) {
+        bounds.emplace_back(t + 1);
+        start = t + 1;
+        total = 0;
+        time += cacheSize + 1;
+      }
+    }
+
+    if (bounds.back() != hard[h + 1])
+      bounds.emplace_back(hard[h + 1]);
+  }
+
+  return bounds;
+}
+
+} // namespace ge
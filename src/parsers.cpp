@@ -1,13 +1,59 @@
 #include "src/include/parsers.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <map>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace ge {
 
+MappedFile::MappedFile(const std::string& path) {
+  m_file = open(path.c_str(), O_RDONLY);
+  if (m_file < 0) throw std::runtime_error("groot-engine: failed to open " + path);
+
+  struct stat info;
+  if (fstat(m_file, &info) != 0) {
+    close(m_file);
+    throw std::runtime_error("groot-engine: failed to stat " + path);
+  }
+
+  m_size = info.st_size;
+  if (m_size == 0) return;
+
+  m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+  if (m_data == MAP_FAILED) {
+    close(m_file);
+    throw std::runtime_error("groot-engine: failed to map " + path);
+  }
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) : m_file(rhs.m_file), m_data(rhs.m_data), m_size(rhs.m_size) {
+  rhs.m_file = -1;
+  rhs.m_data = nullptr;
+  rhs.m_size = 0;
+}
+
+MappedFile::~MappedFile() {
+  if (m_data != nullptr) munmap(m_data, m_size);
+  if (m_file >= 0) close(m_file);
+}
+
+const char * MappedFile::data() const {
+  return reinterpret_cast<const char *>(m_data);
+}
+
+unsigned int MappedFile::size() const {
+  return m_size;
+}
+
 ObjParser::Output ObjParser::parse(std::string path) {
   std::ifstream file(path);
   if (!file) throw std::runtime_error("groot-engine: failed to open " + path);
@@ -93,4 +139,68 @@ SPVParser::Output SPVParser::parse(std::string path) {
   return buffer;
 }
 
+MappedFile SPVParser::map(std::string path) {
+  MappedFile file(path);
+
+  if (file.size() < 4)
+    throw std::runtime_error("groot-engine: file too small - " + path);
+
+  if (file.size() % 4 != 0)
+    throw std::runtime_error("groot-engine: corrupted shader - " + path);
+
+  if (*reinterpret_cast<const unsigned int *>(file.data()) != 0x07230203)
+    throw std::runtime_error("groot-engine: incorrect file format - " + path);
+
+  return file;
+}
+
+std::vector<unsigned int> SPVParser::invariantPosition(const char * data, unsigned int size) {
+  static constexpr unsigned int opDecorate = 71;
+  static constexpr unsigned int opMemberDecorate = 72;
+  static constexpr unsigned int builtIn = 11;
+  static constexpr unsigned int invariant = 18;
+  static constexpr unsigned int position = 0;
+  static constexpr unsigned int noMember = ~0u;
+
+  const unsigned int * words = reinterpret_cast<const unsigned int *>(data);
+  unsigned int count = size / sizeof(unsigned int);
+  if (count < 5 || words[0] != 0x07230203)
+    throw std::runtime_error("groot-engine: corrupted shader");
+
+  // decoration targets as (id, member), member is noMember for OpDecorate
+  auto decoration = [words](unsigned int i) {
+    unsigned int opcode = words[i] & 0xffff;
+    unsigned int length = words[i] >> 16;
+    if (opcode == opDecorate && length >= 3)
+      return std::make_tuple(std::make_pair(words[i + 1], noMember), words[i + 2], length > 3 ? words[i + 3] : noMember);
+    if (opcode == opMemberDecorate && length >= 4)
+      return std::make_tuple(std::make_pair(words[i + 1], words[i + 2]), words[i + 3], length > 4 ? words[i + 4] : noMember);
+    return std::make_tuple(std::make_pair(noMember, noMember), noMember, noMember);
+  };
+
+  std::set<std::pair<unsigned int, unsigned int>> invariants;
+  for (unsigned int i = 5; i < count; i += words[i] >> 16) {
+    if ((words[i] >> 16) == 0 || i + (words[i] >> 16) > count)
+      throw std::runtime_error("groot-engine: corrupted shader");
+
+    auto [target, kind, value] = decoration(i);
+    if (kind == invariant) invariants.insert(target);
+  }
+
+  std::vector<unsigned int> out(words, words + 5);
+  for (unsigned int i = 5; i < count; i += words[i] >> 16) {
+    out.insert(out.end(), words + i, words + i + (words[i] >> 16));
+
+    auto [target, kind, value] = decoration(i);
+    if (kind != builtIn || value != position || invariants.contains(target)) continue;
+
+    if (target.second == noMember)
+      out.insert(out.end(), { (3u << 16) | opDecorate, target.first, invariant });
+    else
+      out.insert(out.end(), { (4u << 16) | opMemberDecorate, target.first, target.second, invariant });
+  }
+
+  return out;
+}
+
 } // namespace ge
\ No newline at end of file
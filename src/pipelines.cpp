@@ -0,0 +1,118 @@
+#include "src/include/engine.hpp"
+#include "src/include/pipelines.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace ge {
+
+PipelineCacheStatistics PipelineCache::statistics() const {
+  return PipelineCacheStatistics{
+    .loaded     = m_loaded,
+    .pipelines  = m_pipelines,
+    .hits       = m_hits
+  };
+}
+
+void PipelineCache::load(const Engine& engine) {
+  m_path = engine.m_settings.pipeline_cache_path;
+
+  std::vector<char> data;
+  if (!m_path.empty()) {
+    std::ifstream file(m_path, std::ios::binary);
+    Header stored;
+
+    if (file && file.read(reinterpret_cast<char *>(&stored), sizeof(Header))) {
+      Header expected = header(engine);
+      expected.size = stored.size;
+
+      if (stored == expected) {
+        data.resize(stored.size);
+        if (file.read(data.data(), data.size()))
+          m_loaded = true;
+        else
+          data.clear();
+      }
+    }
+  }
+
+  m_cache = engine.m_context.device().createPipelineCache(vk::PipelineCacheCreateInfo{
+    .initialDataSize  = data.size(),
+    .pInitialData     = data.data()
+  });
+}
+
+void PipelineCache::save(const Engine& engine) const {
+  if (m_path.empty() || *m_cache == nullptr) return;
+
+  // the cache is optional and saved from the engine destructor, so failures skip the save
+  std::vector<unsigned char> data;
+  try {
+    data = m_cache.getData();
+  }
+  catch (const vk::SystemError&) {
+    return;
+  }
+
+  Header out = header(engine);
+  out.size = data.size();
+
+  std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+  if (!file) return;
+
+  file.write(reinterpret_cast<const char *>(&out), sizeof(Header));
+  file.write(reinterpret_cast<const char *>(data.data()), data.size());
+}
+
+vk::raii::Pipeline PipelineCache::createGraphicsPipeline(const Engine& engine, vk::GraphicsPipelineCreateInfo info) const {
+  vk::PipelineCreationFeedback feedback;
+  vk::PipelineCreationFeedbackCreateInfo ci_feedback{
+    .pNext                      = info.pNext,
+    .pPipelineCreationFeedback  = &feedback
+  };
+  info.pNext = &ci_feedback;
+
+  vk::raii::Pipeline pipeline = engine.m_context.device().createGraphicsPipeline(m_cache, info);
+  record(feedback);
+  return pipeline;
+}
+
+vk::raii::Pipeline PipelineCache::createComputePipeline(const Engine& engine, vk::ComputePipelineCreateInfo info) const {
+  vk::PipelineCreationFeedback feedback;
+  vk::PipelineCreationFeedbackCreateInfo ci_feedback{
+    .pNext                      = info.pNext,
+    .pPipelineCreationFeedback  = &feedback
+  };
+  info.pNext = &ci_feedback;
+
+  vk::raii::Pipeline pipeline = engine.m_context.device().createComputePipeline(m_cache, info);
+  record(feedback);
+  return pipeline;
+}
+
+PipelineCache::Header PipelineCache::header(const Engine& engine) const {
+  auto chain = engine.m_context.gpu().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceIDProperties>();
+  const vk::PhysicalDeviceProperties& properties = chain.get<vk::PhysicalDeviceProperties2>().properties;
+  const vk::PhysicalDeviceIDProperties& ids = chain.get<vk::PhysicalDeviceIDProperties>();
+
+  Header out{
+    .vendorID       = properties.vendorID,
+    .deviceID       = properties.deviceID,
+    .driverVersion  = properties.driverVersion
+  };
+
+  std::memcpy(out.deviceUUID.data(), ids.deviceUUID.data(), VK_UUID_SIZE);
+  std::memcpy(out.pipelineCacheUUID.data(), properties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+  return out;
+}
+
+void PipelineCache::record(const vk::PipelineCreationFeedback& feedback) const {
+  ++m_pipelines;
+
+  if (
+    (feedback.flags & vk::PipelineCreationFeedbackFlagBits::eValid) &&
+    (feedback.flags & vk::PipelineCreationFeedbackFlagBits::eApplicationPipelineCacheHit)
+  ) ++m_hits;
+}
+
+} // namespace ge
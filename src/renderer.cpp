@@ -10,13 +10,38 @@ const unsigned int& Renderer::frameIndex() const {
   return m_frameIndex;
 }
 
+const mat4& Renderer::view() const {
+  return m_view;
+}
+
+const mat4& Renderer::projection() const {
+  return m_projection;
+}
+
+mat4 Renderer::viewProjection() const {
+  return m_projection * m_view;
+}
+
+vec3 Renderer::cameraPosition() const {
+  return -(m_view[0].xyz() * m_view[0].w + m_view[1].xyz() * m_view[1].w + m_view[2].xyz() * m_view[2].w);
+}
+
+const vk::raii::ImageView& Renderer::depthView() const {
+  return m_depthView;
+}
+
 void Renderer::initialize(Engine& engine) {
-  checkFormat(engine);
-  checkPresentMode(engine);
-  auto [imageCount, transform] = checkExtent(engine);
+  if (*engine.m_surface != nullptr) {
+    checkFormat(engine);
+    checkPresentMode(engine);
+    auto [imageCount, transform] = checkExtent(engine);
 
-  createSwapchain(engine, imageCount, transform);
-  createViews(engine);
+    createSwapchain(engine, imageCount, transform);
+    createViews(engine);
+  }
+  else {
+    createOffscreenImages(engine);
+  }
 
   auto [tmp_dMem, tmp_dImg, tmp_dView] = Allocator::depthResources(engine);
   m_depthMem = std::move(tmp_dMem);
@@ -31,47 +56,82 @@ void Renderer::initialize(Engine& engine) {
   m_projection = mat4::perspective(std::numbers::pi / 3.0f, ar, 0.01f, 10000.0f);
 }
 
-void Renderer::render(const Engine& engine) {
+void Renderer::waitForFrame(const Engine& engine) const {
   if (engine.m_context.device().waitForFences(*m_flightFences[m_frameIndex], true, ge_timeout) != vk::Result::eSuccess)
     throw std::runtime_error("groot-engine: hung waiting for flight fence");
+}
 
-  auto [res, imgIndex] = m_swapchain.acquireNextImage(ge_timeout, m_imageSemaphores[m_frameIndex], nullptr);
-  if (res != vk::Result::eSuccess) throw std::runtime_error("groot-engine: failed to get next swapchain image");
+void Renderer::render(const Engine& engine) {
+  waitForFrame(engine);
+
+  bool offscreen = *m_swapchain == nullptr;
+  unsigned int imgIndex = m_frameIndex;
+  if (!offscreen) {
+    auto [res, index] = m_swapchain.acquireNextImage(ge_timeout, m_imageSemaphores[m_frameIndex], nullptr);
+    if (res != vk::Result::eSuccess) throw std::runtime_error("groot-engine: failed to get next swapchain image");
+    imgIndex = index;
+  }
 
   engine.m_context.device().resetFences(*m_flightFences[m_frameIndex]);
 
   m_renderCmds[m_frameIndex].reset();
   m_renderCmds[m_frameIndex].begin({});
 
+  if (
+    engine.m_settings.culling_mode == GPUCulling ||
+    engine.m_settings.culling_mode == OcclusionCulling ||
+    engine.m_settings.culling_mode == ClusterCulling
+  ) engine.m_compute.cull(m_renderCmds[m_frameIndex], m_frameIndex, viewProjection(), cameraPosition());
+
+  engine.m_materials.updateCamera(m_frameIndex, CameraData::compute(m_view, m_projection));
+
   transitionImages(imgIndex);
+  bindMaterialSets(engine);
   preDraw(engine, imgIndex);
   draw(engine);
 
+  if (engine.m_settings.culling_mode == OcclusionCulling) {
+    engine.m_compute.buildPyramid(m_renderCmds[m_frameIndex], m_depthImage);
+    engine.m_compute.cull(m_renderCmds[m_frameIndex], m_frameIndex, viewProjection(), cameraPosition(), 1);
+
+    preDraw(engine, imgIndex, vk::AttachmentLoadOp::eLoad);
+    draw(engine, 1);
+  }
+
+  if (
+    engine.m_settings.culling_mode == GPUCulling ||
+    engine.m_settings.culling_mode == OcclusionCulling ||
+    engine.m_settings.culling_mode == ClusterCulling
+  ) engine.m_compute.readCounts(m_renderCmds[m_frameIndex], m_frameIndex);
+
+  finishImage(imgIndex);
   m_renderCmds[m_frameIndex].end();
 
   const vk::PipelineStageFlags waitStage =  vk::PipelineStageFlagBits::eColorAttachmentOutput;
   vk::SubmitInfo renderSubmit{
-    .waitSemaphoreCount   = 1,
+    .waitSemaphoreCount   = offscreen ? 0u : 1u,
     .pWaitSemaphores      = &*m_imageSemaphores[m_frameIndex],
     .pWaitDstStageMask    = &waitStage,
     .commandBufferCount   = 1,
     .pCommandBuffers      = &*m_renderCmds[m_frameIndex],
-    .signalSemaphoreCount = 1,
+    .signalSemaphoreCount = offscreen ? 0u : 1u,
     .pSignalSemaphores    = &*m_renderSemaphores[m_frameIndex]
   };
 
   engine.m_context.queueFamily(QueueFamilyType::Main).queue.submit(renderSubmit, m_flightFences[m_frameIndex]);
 
-  vk::PresentInfoKHR present{
-    .waitSemaphoreCount = 1,
-    .pWaitSemaphores    = &*m_renderSemaphores[m_frameIndex],
-    .swapchainCount     = 1,
-    .pSwapchains        = &*m_swapchain,
-    .pImageIndices      = &imgIndex
-  };
-
-  if (engine.m_context.queueFamily(QueueFamilyType::Main).queue.presentKHR(present) != vk::Result::eSuccess)
-    throw std::runtime_error("groot-engine: failed to present image");
+  if (!offscreen) {
+    vk::PresentInfoKHR present{
+      .waitSemaphoreCount = 1,
+      .pWaitSemaphores    = &*m_renderSemaphores[m_frameIndex],
+      .swapchainCount     = 1,
+      .pSwapchains        = &*m_swapchain,
+      .pImageIndices      = &imgIndex
+    };
+
+    if (engine.m_context.queueFamily(QueueFamilyType::Main).queue.presentKHR(present) != vk::Result::eSuccess)
+      throw std::runtime_error("groot-engine: failed to present image");
+  }
 
   m_frameIndex = (m_frameIndex + 1) % engine.m_settings.buffer_mode;
 }
@@ -109,8 +169,10 @@ std::pair<unsigned int, vk::SurfaceTransformFlagBitsKHR> Renderer::checkExtent(E
     return std::make_pair(imageCount, capabilities.currentTransform);
   }
 
-  int width, height;
-  glfwGetFramebufferSize(engine.m_window, &width, &height);
+  int width = engine.m_settings.extent.width;
+  int height = engine.m_settings.extent.height;
+  if (engine.m_window != nullptr)
+    glfwGetFramebufferSize(engine.m_window, &width, &height);
 
   engine.m_settings.extent = vk::Extent2D{
     std::clamp(static_cast<unsigned int>(width),
@@ -147,6 +209,31 @@ void Renderer::createSwapchain(
   m_images = std::move(m_swapchain.getImages());
 }
 
+void Renderer::createOffscreenImages(const Engine& engine) {
+  vk::FormatProperties properties = engine.m_context.gpu().getFormatProperties(engine.m_settings.format);
+  if (!(properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eColorAttachment))
+    throw std::runtime_error("groot-engine: invalid offscreen format");
+
+  for (unsigned int i = 0; i < engine.m_settings.buffer_mode; ++i) {
+    auto [memory, image, view] = Allocator::imageResources(engine, vk::ImageCreateInfo{
+      .imageType    = vk::ImageType::e2D,
+      .format       = engine.m_settings.format,
+      .extent       = vk::Extent3D{ engine.m_settings.extent.width, engine.m_settings.extent.height, 1 },
+      .mipLevels    = 1,
+      .arrayLayers  = 1,
+      .samples      = vk::SampleCountFlagBits::e1,
+      .tiling       = vk::ImageTiling::eOptimal,
+      .usage        = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+      .sharingMode  = vk::SharingMode::eExclusive
+    }, vk::ImageAspectFlagBits::eColor);
+
+    m_images.emplace_back(*image);
+    m_offscreenMemory.emplace_back(std::move(memory));
+    m_offscreenImages.emplace_back(std::move(image));
+    m_views.emplace_back(std::move(view));
+  }
+}
+
 void Renderer::createViews(const Engine& engine) {
   for (const auto& image : m_images) {
     m_views.emplace_back(engine.m_context.device().createImageView(vk::ImageViewCreateInfo{
@@ -189,29 +276,40 @@ void Renderer::transitionImages(const unsigned int& imgIndex) {
     barrier
   );
 
-  barrier.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
-  barrier.dstAccessMask = vk::AccessFlagBits::eNone;
-  barrier.oldLayout = vk::ImageLayout::eColorAttachmentOptimal;
-  barrier.newLayout = vk::ImageLayout::ePresentSrcKHR;
+  barrier.dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentWrite;
+  barrier.newLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+  barrier.image = m_depthImage;
+  barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eDepth;
 
   m_renderCmds[m_frameIndex].pipelineBarrier(
-    vk::PipelineStageFlagBits::eColorAttachmentOutput,
-    vk::PipelineStageFlagBits::eBottomOfPipe,
+    vk::PipelineStageFlagBits::eTopOfPipe,
+    vk::PipelineStageFlagBits::eEarlyFragmentTests,
     vk::DependencyFlags(),
     nullptr,
     nullptr,
     barrier
   );
+}
 
-  barrier.srcAccessMask = barrier.dstAccessMask;
-  barrier.oldLayout = vk::ImageLayout::eUndefined;
-  barrier.newLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
-  barrier.image = m_depthImage;
-  barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eDepth;
+void Renderer::finishImage(const unsigned int& imgIndex) {
+  bool offscreen = *m_swapchain == nullptr;
+
+  vk::ImageMemoryBarrier barrier{
+    .srcAccessMask    = vk::AccessFlagBits::eColorAttachmentWrite,
+    .dstAccessMask    = offscreen ? vk::AccessFlagBits::eTransferRead : vk::AccessFlagBits::eNone,
+    .oldLayout        = vk::ImageLayout::eColorAttachmentOptimal,
+    .newLayout        = offscreen ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::ePresentSrcKHR,
+    .image            = m_images[imgIndex],
+    .subresourceRange = {
+      .aspectMask = vk::ImageAspectFlagBits::eColor,
+      .levelCount = 1,
+      .layerCount = 1
+    }
+  };
 
   m_renderCmds[m_frameIndex].pipelineBarrier(
-    vk::PipelineStageFlagBits::eTopOfPipe,
-    vk::PipelineStageFlagBits::eEarlyFragmentTests,
+    vk::PipelineStageFlagBits::eColorAttachmentOutput,
+    offscreen ? vk::PipelineStageFlagBits::eTransfer : vk::PipelineStageFlagBits::eBottomOfPipe,
     vk::DependencyFlags(),
     nullptr,
     nullptr,
@@ -219,11 +317,11 @@ void Renderer::transitionImages(const unsigned int& imgIndex) {
   );
 }
 
-void Renderer::preDraw(const Engine& engine, const unsigned int& imgIndex) {
+void Renderer::preDraw(const Engine& engine, const unsigned int& imgIndex, vk::AttachmentLoadOp loadOp) {
   vk::RenderingAttachmentInfo color{
     .imageView    = m_views[imgIndex],
     .imageLayout  = vk::ImageLayout::eColorAttachmentOptimal,
-    .loadOp       = vk::AttachmentLoadOp::eClear,
+    .loadOp       = loadOp,
     .storeOp      = vk::AttachmentStoreOp::eStore,
     .clearValue   = { engine.m_settings.background_color }
   };
@@ -231,8 +329,9 @@ void Renderer::preDraw(const Engine& engine, const unsigned int& imgIndex) {
   vk::RenderingAttachmentInfo depth{
     .imageView    = m_depthView,
     .imageLayout  = vk::ImageLayout::eDepthAttachmentOptimal,
-    .loadOp       = vk::AttachmentLoadOp::eClear,
-    .storeOp      = vk::AttachmentStoreOp::eDontCare,
+    .loadOp       = loadOp,
+    .storeOp      = engine.m_settings.culling_mode == OcclusionCulling ?
+                    vk::AttachmentStoreOp::eStore : vk::AttachmentStoreOp::eDontCare,
     .clearValue   = { .depthStencil = { 1, 0 } }
   };
 
@@ -258,44 +357,137 @@ void Renderer::preDraw(const Engine& engine, const unsigned int& imgIndex) {
   m_renderCmds[m_frameIndex].setScissor(0, vk::Rect2D{ .extent = engine.m_settings.extent });
 }
 
-void Renderer::draw(const Engine& engine) {
+void Renderer::draw(const Engine& engine, unsigned int phase) {
+  if (engine.m_settings.depth_prepass)
+    drawMaterials(engine, phase, DepthPass);
+
+  drawMaterials(engine, phase, OpaquePass);
+
+  if (phase == 0 && engine.m_settings.impostor_distance > 0.0f) {
+    engine.m_impostors.draw(m_renderCmds[m_frameIndex], m_frameIndex, viewProjection(), m_view);
+    bindMaterialSets(engine);
+  }
+
+  // occlusion culling blends both phases' transparent objects after the last opaque pass
+  if (engine.m_settings.culling_mode != OcclusionCulling || phase == 1)
+    drawMaterials(engine, phase, TransparentPass);
+
+  m_renderCmds[m_frameIndex].endRendering();
+}
+
+void Renderer::bindMaterialSets(const Engine& engine) {
+  vk::DescriptorSet sets[2] = {
+    *engine.m_materials.descriptorSet(m_frameIndex),
+    *engine.m_materials.cameraSet()
+  };
+
+  m_renderCmds[m_frameIndex].bindDescriptorSets(
+    vk::PipelineBindPoint::eGraphics,
+    engine.m_materials.layout(),
+    0,
+    sets,
+    engine.m_materials.cameraOffset(m_frameIndex)
+  );
+}
+
+void Renderer::drawMaterials(const Engine& engine, unsigned int phase, Pass pass) {
   EngineData engineData{
-    .view           = m_view,
-    .projection     = m_projection,
-    .frameIndex     = m_frameIndex
+    .frameIndex = m_frameIndex
   };
 
-  unsigned int materialIndex = 0;
-  for (const auto& [material, pipeline] : engine.m_materials) {
-    engineData.materialIndex = materialIndex++;
-    if (!engine.m_objects.hasObjects(material)) continue;
+  const vk::raii::Pipeline * bound = nullptr;
+  for (const std::string& material : engine.m_objects.drawOrder()) {
+    if (engine.m_materials.transparent().contains(material) != (pass == TransparentPass)) continue;
+    if (pass == DepthPass && !engine.m_materials.prepass(material)) continue;
+
+    engineData.materialIndex = engine.m_materials.index(material);
+
+    bool hasObjects = engine.m_objects.hasObjects(material);
+    bool hasDynamicObjects = engine.m_objects.hasDynamicObjects(material);
+    if (!hasObjects && !hasDynamicObjects) continue;
+
+    const vk::raii::Pipeline& pipeline = pass == DepthPass ?
+      engine.m_materials.depthPipeline(material) : engine.m_materials.pipeline(material);
+
+    if (&pipeline != bound) {
+      m_renderCmds[m_frameIndex].bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+      bound = &pipeline;
+    }
+
+    bool vertexPulling = engine.m_materials.vertexPulling(material);
+
+    for (unsigned int drawPhase = pass == TransparentPass ? 0 : phase; drawPhase <= phase; ++drawPhase) {
+      if (hasObjects)
+        drawObjects(engine, engineData, engine.m_objects.staticObjects(material, m_frameIndex), vertexPulling, drawPhase);
 
-    m_renderCmds[m_frameIndex].bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+      if (hasDynamicObjects)
+        drawObjects(engine, engineData, engine.m_objects.dynamicObjects(material, m_frameIndex), vertexPulling, drawPhase);
+    }
+  }
+}
 
+void Renderer::drawObjects(
+  const Engine& engine,
+  EngineData& engineData,
+  const ObjectManager::Output& objects,
+  bool vertexPulling,
+  unsigned int phase
+) {
+  const auto& [vertexBuffer, indexBuffer, indirectBuffer, vertexSet, indexType, commandCount, transformIndex, batchIndex] = objects;
+  engineData.transformIndex = transformIndex;
+
+  m_renderCmds[m_frameIndex].pushConstants(
+    engine.m_materials.layout(),
+    all_stages,
+    0,
+    vk::ArrayProxy<const char>(sizeof(EngineData), reinterpret_cast<const char *>(&engineData))
+  );
+
+  if (vertexPulling) {
     m_renderCmds[m_frameIndex].bindDescriptorSets(
       vk::PipelineBindPoint::eGraphics,
       engine.m_materials.layout(),
-      0,
-      *engine.m_materials.descriptorSet(m_frameIndex),
+      2,
+      *vertexSet,
       nullptr
     );
+  }
+  else {
+    m_renderCmds[m_frameIndex].bindVertexBuffers(0, *vertexBuffer, { 0 });
+  }
 
-    const auto& [vertexBuffer, indexBuffer, indirectBuffer, commandCount, transformIndex] = engine.m_objects[material];
-    engineData.transformIndex = transformIndex;
+  m_renderCmds[m_frameIndex].bindIndexBuffer(indexBuffer, 0, indexType);
 
-    m_renderCmds[m_frameIndex].pushConstants(
-      engine.m_materials.layout(),
-      all_stages,
-      0,
-      vk::ArrayProxy<const char>(sizeof(EngineData), reinterpret_cast<const char *>(&engineData))
+  if (engine.m_settings.culling_mode == GPUCulling || engine.m_settings.culling_mode == OcclusionCulling) {
+    m_renderCmds[m_frameIndex].drawIndexedIndirectCount(
+      engine.m_compute.drawBuffer(m_frameIndex),
+      engine.m_compute.drawOffset(phase) + transformIndex * engine.m_objects.commandSize(),
+      engine.m_compute.countBuffer(m_frameIndex),
+      engine.m_compute.countOffset(phase) + batchIndex * sizeof(unsigned int),
+      commandCount,
+      engine.m_objects.commandSize()
+    );
+  }
+  else if (engine.m_settings.culling_mode == ClusterCulling) {
+    auto [firstCluster, clusterCount] = engine.m_objects.clusters(batchIndex);
+
+    m_renderCmds[m_frameIndex].drawIndexedIndirectCount(
+      engine.m_compute.drawBuffer(m_frameIndex),
+      firstCluster * engine.m_objects.commandSize(),
+      engine.m_compute.countBuffer(m_frameIndex),
+      batchIndex * sizeof(unsigned int),
+      clusterCount,
+      engine.m_objects.commandSize()
+    );
+  }
+  else {
+    m_renderCmds[m_frameIndex].drawIndexedIndirect(
+      indirectBuffer,
+      transformIndex * engine.m_objects.commandSize(),
+      commandCount,
+      engine.m_objects.commandSize()
     );
-
-    m_renderCmds[m_frameIndex].bindVertexBuffers(0, *vertexBuffer, { 0 });
-    m_renderCmds[m_frameIndex].bindIndexBuffer(indexBuffer, 0, vk::IndexType::eUint32);
-
-    m_renderCmds[m_frameIndex].drawIndexedIndirect(indirectBuffer, 0, commandCount, engine.m_objects.commandSize());
   }
-  m_renderCmds[m_frameIndex].endRendering();
 }
 
 } // namespace ge
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "src/include/engine.hpp"
+#include "src/include/parsers.hpp"
+#include "src/include/shaders.hpp"
+
+namespace ge {
+
+unsigned int ShaderRegistry::size() const {
+  std::lock_guard lock(m_mutex);
+  return m_modules.size();
+}
+
+const vk::raii::ShaderModule& ShaderRegistry::module(const Engine& engine, const std::string& path, bool invariant) const {
+  MappedFile code = SPVParser::map(path);
+  Key key(path, hash(code.data(), code.size()), invariant);
+
+  std::lock_guard lock(m_mutex);
+  auto it = m_modules.find(key);
+  if (it != m_modules.end()) return it->second;
+
+  if (!invariant) {
+    return m_modules.emplace(key, engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
+      .codeSize = code.size(),
+      .pCode    = reinterpret_cast<const unsigned int *>(code.data())
+    })).first->second;
+  }
+
+  std::vector<unsigned int> patched = SPVParser::invariantPosition(code.data(), code.size());
+  return m_modules.emplace(key, engine.m_context.device().createShaderModule(vk::ShaderModuleCreateInfo{
+    .codeSize = patched.size() * sizeof(unsigned int),
+    .pCode    = patched.data()
+  })).first->second;
+}
+
+unsigned long long ShaderRegistry::hash(const char * data, unsigned int size) {
+  unsigned long long value = 0xcbf29ce484222325ull;
+  for (unsigned int i = 0; i < size; ++i) {
+    value ^= static_cast<unsigned char>(data[i]);
+    value *= 0x100000001b3ull;
+  }
+  return value;
+}
+
+} // namespace ge
@@ -0,0 +1,7 @@
+#version 460
+
+layout(location = 0) out vec4 frag_color;
+
+void main() {
+  frag_color = vec4(0.5, 0.5, 0.5, 1.0);
+}
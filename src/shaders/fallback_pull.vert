@@ -0,0 +1,35 @@
+#version 460
+
+layout(constant_id = 0) const uint ge_Stride = 8;
+
+layout(set = 0, binding = 0) readonly buffer transforms {
+  layout(row_major) mat4 ge_Models[];
+};
+
+layout(set = 2, binding = 0) readonly buffer vertices {
+  float ge_Vertices[];
+};
+
+layout(set = 1, binding = 0) uniform camera {
+  layout(row_major) mat4 ge_View;
+  layout(row_major) mat4 ge_Projection;
+  layout(row_major) mat4 ge_ViewProjection;
+  layout(row_major) mat4 ge_InverseView;
+  layout(row_major) mat4 ge_InverseProjection;
+  layout(row_major) mat4 ge_InverseViewProjection;
+  vec4 ge_CameraPosition;
+};
+
+layout(push_constant) uniform push_constants {
+  uint ge_Frame;
+  uint ge_Material;
+  uint ge_Transform;
+};
+
+void main() {
+  uint transform_index = ge_Transform + gl_BaseInstance;
+  uint first = gl_VertexIndex * ge_Stride;
+  vec3 position = vec3(ge_Vertices[first], ge_Vertices[first + 1], ge_Vertices[first + 2]);
+
+  gl_Position = ge_ViewProjection * ge_Models[transform_index] * vec4(position, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 460
+
+layout(set = 1, binding = 0) uniform sampler2D ge_Atlas;
+
+layout(push_constant) uniform push_constants {
+  layout(row_major) mat4 ge_ViewProjection;
+  vec4 ge_Right;
+  vec4 ge_Up;
+  uint ge_Columns;
+  uint ge_Rows;
+};
+
+layout(location = 0) in vec2 uv;
+layout(location = 1) flat in uint tile;
+
+layout(location = 0) out vec4 frag_color;
+
+void main() {
+  vec2 cell = vec2(tile % ge_Columns, tile / ge_Columns);
+  vec4 color = texture(ge_Atlas, (cell + uv) / vec2(ge_Columns, ge_Rows));
+  if (color.a < 0.5) discard;
+
+  frag_color = color;
+}
@@ -0,0 +1,37 @@
+#version 460
+
+struct Instance {
+  vec4 sphere;
+  uint tile;
+};
+
+layout(set = 0, binding = 0) readonly buffer instances {
+  Instance ge_Instances[];
+};
+
+layout(push_constant) uniform push_constants {
+  layout(row_major) mat4 ge_ViewProjection;
+  vec4 ge_Right;
+  vec4 ge_Up;
+  uint ge_Columns;
+  uint ge_Rows;
+};
+
+layout(location = 0) out vec2 uv_out;
+layout(location = 1) flat out uint tile_out;
+
+const vec2 corners[6] = vec2[](
+  vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+  vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0)
+);
+
+void main() {
+  Instance instance = ge_Instances[gl_InstanceIndex];
+  vec2 corner = corners[gl_VertexIndex];
+
+  vec3 position = instance.sphere.xyz + (ge_Right.xyz * corner.x + ge_Up.xyz * corner.y) * instance.sphere.w;
+
+  gl_Position = ge_ViewProjection * vec4(position, 1.0);
+  uv_out = corner * 0.5 + 0.5;
+  tile_out = instance.tile;
+}
@@ -0,0 +1,16 @@
+#ifndef GE_OCTAHEDRAL_GLSL
+#define GE_OCTAHEDRAL_GLSL
+
+// decodes the eR16G16Snorm normal at location 2 used by CompactVertices
+vec3 octDecode(vec2 encoded) {
+  vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+
+  if (normal.z < 0.0) {
+    vec2 signs = vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+    normal.xy = (1.0 - abs(normal.yx)) * signs;
+  }
+
+  return normalize(normal);
+}
+
+#endif
@@ -0,0 +1,268 @@
+#include "src/include/simplifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <numeric>
+
+namespace ge {
+
+MeshSimplifier::Quadric& MeshSimplifier::Quadric::operator+=(const Quadric& other) {
+  a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+  b2 += other.b2; bc += other.bc; bd += other.bd;
+  c2 += other.c2; cd += other.cd;
+  d2 += other.d2;
+  return *this;
+}
+
+MeshSimplifier::Quadric MeshSimplifier::Quadric::operator+(const Quadric& other) const {
+  Quadric sum = *this;
+  sum += other;
+  return sum;
+}
+
+double MeshSimplifier::Quadric::error(const vec3& p) const {
+  double x = p.x, y = p.y, z = p.z;
+  return a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+         b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+         c2 * z * z + 2.0 * cd * z +
+         d2;
+}
+
+MeshSimplifier::Output MeshSimplifier::simplify(
+  const std::vector<Vertex>& vertices,
+  const std::vector<unsigned int>& indices,
+  unsigned int targetIndexCount,
+  float targetError
+) {
+  return simplify(vertices.data(), vertices.size(), indices.data(), indices.size(), targetIndexCount, targetError);
+}
+
+MeshSimplifier::Output MeshSimplifier::simplify(
+  const Vertex * vertices,
+  unsigned int vertexCount,
+  const unsigned int * indices,
+  unsigned int indexCount,
+  unsigned int targetIndexCount,
+  float targetError
+) {
+  std::vector<unsigned int> canonical(vertexCount);
+  std::vector<unsigned int> groupSize(vertexCount, 0);
+  std::map<std::array<float, 3>, unsigned int> positions;
+  for (unsigned int i = 0; i < vertexCount; ++i) {
+    const vec3& p = vertices[i].m_position;
+    canonical[i] = positions.try_emplace({ p.x, p.y, p.z }, i).first->second;
+    ++groupSize[canonical[i]];
+  }
+
+  std::vector<unsigned int> remap(vertexCount);
+  std::iota(remap.begin(), remap.end(), 0);
+
+  auto find = [&remap](unsigned int v) {
+    while (remap[v] != v) v = remap[v] = remap[remap[v]];
+    return v;
+  };
+
+  auto position = [vertices](unsigned int v) -> const vec3& {
+    return vertices[v].m_position;
+  };
+
+  std::vector<std::array<unsigned int, 3>> triangles;
+  for (unsigned int i = 0; i + 2 < indexCount; i += 3) {
+    unsigned int a = canonical[indices[i]], b = canonical[indices[i + 1]], c = canonical[indices[i + 2]];
+    if (a != b && b != c && c != a)
+      triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+  }
+
+  std::vector<Quadric> quadrics(vertexCount);
+  std::vector<bool> locked(vertexCount, false);
+  std::map<std::pair<unsigned int, unsigned int>, unsigned int> edgeUses;
+
+  vec3 lo = vertexCount > 0 ? position(0) : vec3(0.0f);
+  vec3 hi = lo;
+  for (unsigned int i = 0; i < vertexCount; ++i) {
+    const vec3& p = position(i);
+    lo = vec3(std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z));
+    hi = vec3(std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z));
+
+    if (groupSize[canonical[i]] > 1) locked[canonical[i]] = true;
+  }
+
+  for (const auto& tri : triangles) {
+    unsigned int c[3] = { canonical[tri[0]], canonical[tri[1]], canonical[tri[2]] };
+    Quadric q = plane(position(c[0]), position(c[1]), position(c[2]));
+    for (unsigned int k = 0; k < 3; ++k) {
+      quadrics[c[k]] += q;
+      ++edgeUses[std::minmax(c[k], c[(k + 1) % 3])];
+    }
+  }
+
+  for (const auto& [edge, uses] : edgeUses) {
+    if (uses == 1) locked[edge.first] = locked[edge.second] = true;
+  }
+
+  double extent = (hi - lo).magnitude();
+  double errorLimit = targetError * extent * targetError * extent;
+
+  struct Collapse {
+    unsigned int from = 0;
+    unsigned int to = 0;
+    double cost = 0.0;
+  };
+
+  while (triangles.size() * 3 > targetIndexCount) {
+    std::vector<std::vector<unsigned int>> adjacency(vertexCount);
+    std::vector<std::pair<unsigned int, unsigned int>> edges;
+    for (unsigned int t = 0; t < triangles.size(); ++t) {
+      for (unsigned int k = 0; k < 3; ++k) {
+        unsigned int a = find(canonical[triangles[t][k]]);
+        unsigned int b = find(canonical[triangles[t][(k + 1) % 3]]);
+        adjacency[a].emplace_back(t);
+        edges.emplace_back(std::minmax(a, b));
+      }
+    }
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<Collapse> collapses;
+    for (const auto& [a, b] : edges) {
+      Quadric q = quadrics[a] + quadrics[b];
+
+      Collapse best{ .cost = -1.0 };
+      if (!locked[a]) best = Collapse{ .from = a, .to = b, .cost = q.error(position(b)) };
+      if (!locked[b]) {
+        double cost = q.error(position(a));
+        if (best.cost < 0.0 || cost < best.cost) best = Collapse{ .from = b, .to = a, .cost = cost };
+      }
+
+      if (best.cost >= 0.0 && best.cost <= errorLimit)
+        collapses.emplace_back(best);
+    }
+
+    if (collapses.empty()) break;
+
+    std::sort(collapses.begin(), collapses.end(), [](const Collapse& l, const Collapse& r) {
+      return l.cost < r.cost;
+    });
+
+    std::vector<bool> touched(vertexCount, false);
+    unsigned int remaining = triangles.size();
+    unsigned int applied = 0;
+
+    for (const auto& collapse : collapses) {
+      if (remaining * 3 <= targetIndexCount) break;
+      if (touched[collapse.from] || touched[collapse.to]) continue;
+
+      bool flipped = false;
+      unsigned int removed = 0;
+      for (unsigned int t : adjacency[collapse.from]) {
+        unsigned int c[3] = {
+          find(canonical[triangles[t][0]]),
+          find(canonical[triangles[t][1]]),
+          find(canonical[triangles[t][2]])
+        };
+
+        if (c[0] == collapse.to || c[1] == collapse.to || c[2] == collapse.to) {
+          ++removed;
+          continue;
+        }
+
+        vec3 p[3] = { position(c[0]), position(c[1]), position(c[2]) };
+        vec3 before = (p[1] - p[0]).cross(p[2] - p[0]);
+        for (unsigned int k = 0; k < 3; ++k) {
+          if (c[k] == collapse.from) p[k] = position(collapse.to);
+        }
+        vec3 after = (p[1] - p[0]).cross(p[2] - p[0]);
+
+        if (before * after <= 0.25f * before.magnitude() * after.magnitude()) {
+          flipped = true;
+          break;
+        }
+      }
+
+      if (flipped) continue;
+
+      for (unsigned int t : adjacency[collapse.from]) {
+        for (unsigned int k = 0; k < 3; ++k)
+          touched[find(canonical[triangles[t][k]])] = true;
+      }
+
+      remap[collapse.from] = collapse.to;
+      quadrics[collapse.to] += quadrics[collapse.from];
+      remaining -= removed;
+      ++applied;
+    }
+
+    if (applied == 0) break;
+
+    std::erase_if(triangles, [&](const std::array<unsigned int, 3>& tri) {
+      unsigned int a = find(canonical[tri[0]]), b = find(canonical[tri[1]]), c = find(canonical[tri[2]]);
+      return a == b || b == c || c == a;
+    });
+  }
+
+  Output output;
+  output.reserve(triangles.size() * 3);
+  for (const auto& tri : triangles) {
+    for (unsigned int v : tri) {
+      unsigned int target = find(canonical[v]);
+      output.emplace_back(target == canonical[v] ? v : target);
+    }
+  }
+
+  return output;
+}
+
+MeshSimplifier::LodOutput MeshSimplifier::lods(
+  const std::vector<Vertex>& vertices,
+  const std::vector<unsigned int>& indices,
+  unsigned int levels
+) {
+  return lods(vertices.data(), vertices.size(), indices.data(), indices.size(), levels);
+}
+
+MeshSimplifier::LodOutput MeshSimplifier::lods(
+  const Vertex * vertices,
+  unsigned int vertexCount,
+  const unsigned int * indices,
+  unsigned int indexCount,
+  unsigned int levels
+) {
+  LodOutput output;
+  std::vector<unsigned int> current(indices, indices + indexCount);
+
+  float error = 0.01f;
+  for (unsigned int level = 1; level < levels; ++level, error *= 2.0f) {
+    unsigned int target = std::max(current.size() / 6 * 3, static_cast<std::size_t>(3));
+    std::vector<unsigned int> next = simplify(vertices, vertexCount, current.data(), current.size(), target, error);
+
+    if (next.empty() || next.size() * 10 > current.size() * 9) break;
+
+    output.emplace_back(next);
+    current = std::move(next);
+  }
+
+  return output;
+}
+
+MeshSimplifier::Quadric MeshSimplifier::plane(const vec3& a, const vec3& b, const vec3& c) {
+  vec3 normal = (b - a).cross(c - a);
+  float area = normal.magnitude();
+  if (area == 0.0f) return Quadric();
+
+  normal = normal * (1.0f / area);
+  double x = normal.x, y = normal.y, z = normal.z;
+  double d = -(normal * a);
+  double w = area * 0.5;
+
+  return Quadric{
+    .a2 = w * x * x, .ab = w * x * y, .ac = w * x * z, .ad = w * x * d,
+    .b2 = w * y * y, .bc = w * y * z, .bd = w * y * d,
+    .c2 = w * z * z, .cd = w * z * d,
+    .d2 = w * d * d
+  };
+}
+
+} // namespace ge
@@ -0,0 +1,200 @@
+#include "src/include/textures.hpp"
+#include "src/include/allocator.hpp"
+#include "src/include/engine.hpp"
+
+#include <cstring>
+
+namespace ge {
+
+bool TextureManager::exists(const std::string& tag) const {
+  return m_indices.contains(tag);
+}
+
+bool TextureManager::loaded() const {
+  return m_loaded;
+}
+
+unsigned int TextureManager::index(const std::string& tag) const {
+  if (!m_indices.contains(tag))
+    throw std::runtime_error("groot-engine: texture '" + tag + "' does not exist");
+  return m_indices.at(tag);
+}
+
+unsigned int TextureManager::count() const {
+  return m_textures.size();
+}
+
+const vk::raii::ImageView& TextureManager::view(unsigned int index) const {
+  return m_textures[index].view;
+}
+
+const vk::raii::Sampler& TextureManager::sampler(SamplerType type) const {
+  return m_samplers[type];
+}
+
+unsigned int TextureManager::add(
+  const Engine& engine,
+  const std::string& tag,
+  unsigned int width,
+  unsigned int height,
+  const std::vector<unsigned char>& pixels
+) {
+  if (width == 0 || height == 0 || pixels.size() != static_cast<size_t>(width) * height * 4)
+    throw std::runtime_error("groot-engine: texture '" + tag + "' must hold width * height RGBA8 pixels");
+
+  // index 0 is reserved for the default white texture created in load
+  unsigned int index = m_textures.size() + (m_loaded ? 0 : 1);
+  if (index >= ge_max_descriptors)
+    throw std::runtime_error("groot-engine: texture limit of " + std::to_string(ge_max_descriptors) + " reached");
+
+  m_indices.emplace(tag, index);
+  m_textures.emplace_back(Texture{ .width = width, .height = height, .pixels = pixels });
+
+  if (m_loaded)
+    upload(engine, m_textures.size() - 1, 1);
+
+  return index;
+}
+
+void TextureManager::load(const Engine& engine) {
+  m_textures.emplace(m_textures.begin(), Texture{
+    .width  = 1,
+    .height = 1,
+    .pixels = { 255, 255, 255, 255 }
+  });
+
+  createSamplers(engine);
+  upload(engine, 0, m_textures.size());
+  m_loaded = true;
+}
+
+void TextureManager::createSamplers(const Engine& engine) {
+  float anisotropy = engine.m_context.gpu().getProperties().limits.maxSamplerAnisotropy;
+
+  for (unsigned int i = 0; i < sampler_count; ++i) {
+    bool linear = i == LinearRepeat || i == LinearClamp;
+    bool repeat = i == LinearRepeat || i == NearestRepeat;
+
+    vk::Filter filter = linear ? vk::Filter::eLinear : vk::Filter::eNearest;
+    vk::SamplerAddressMode address = repeat ? vk::SamplerAddressMode::eRepeat : vk::SamplerAddressMode::eClampToEdge;
+
+    m_samplers.emplace_back(engine.m_context.device().createSampler(vk::SamplerCreateInfo{
+      .magFilter        = filter,
+      .minFilter        = filter,
+      .mipmapMode       = vk::SamplerMipmapMode::eNearest,
+      .addressModeU     = address,
+      .addressModeV     = address,
+      .addressModeW     = address,
+      .anisotropyEnable = linear,
+      .maxAnisotropy    = linear ? anisotropy : 1.0f
+    }));
+  }
+}
+
+void TextureManager::upload(const Engine& engine, unsigned int first, unsigned int count) {
+  std::vector<vk::BufferCreateInfo> infos;
+  for (unsigned int i = first; i < first + count; ++i) {
+    infos.emplace_back(vk::BufferCreateInfo{
+      .size         = m_textures[i].pixels.size(),
+      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
+      .sharingMode  = vk::SharingMode::eExclusive
+    });
+  }
+
+  auto [transMem, transBufs, transOffs, transSize] = Allocator::bufferPool(engine, infos,
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+  );
+
+  void * map = transMem.mapMemory(0, transSize);
+  for (unsigned int i = 0; i < count; ++i) {
+    const std::vector<unsigned char>& pixels = m_textures[first + i].pixels;
+    memcpy(reinterpret_cast<char *>(map) + transOffs[i], pixels.data(), pixels.size());
+  }
+  transMem.unmapMemory();
+  map = nullptr;
+
+  vk::raii::CommandBuffer cmd = std::move(engine.getCmds(QueueFamilyType::Main, 1)[0]);
+  cmd.begin({ .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+
+  for (unsigned int i = 0; i < count; ++i) {
+    Texture& texture = m_textures[first + i];
+
+    auto [memory, image, view] = Allocator::imageResources(engine, vk::ImageCreateInfo{
+      .imageType    = vk::ImageType::e2D,
+      .format       = vk::Format::eR8G8B8A8Srgb,
+      .extent       = vk::Extent3D{ texture.width, texture.height, 1 },
+      .mipLevels    = 1,
+      .arrayLayers  = 1,
+      .samples      = vk::SampleCountFlagBits::e1,
+      .tiling       = vk::ImageTiling::eOptimal,
+      .usage        = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled,
+      .sharingMode  = vk::SharingMode::eExclusive
+    }, vk::ImageAspectFlagBits::eColor);
+
+    texture.memory = std::move(memory);
+    texture.image = std::move(image);
+    texture.view = std::move(view);
+
+    vk::ImageMemoryBarrier barrier{
+      .dstAccessMask    = vk::AccessFlagBits::eTransferWrite,
+      .oldLayout        = vk::ImageLayout::eUndefined,
+      .newLayout        = vk::ImageLayout::eTransferDstOptimal,
+      .image            = texture.image,
+      .subresourceRange = {
+        .aspectMask = vk::ImageAspectFlagBits::eColor,
+        .levelCount = 1,
+        .layerCount = 1
+      }
+    };
+
+    cmd.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTopOfPipe,
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::DependencyFlags(),
+      nullptr,
+      nullptr,
+      barrier
+    );
+
+    cmd.copyBufferToImage(transBufs[i], texture.image, vk::ImageLayout::eTransferDstOptimal, vk::BufferImageCopy{
+      .imageSubresource = {
+        .aspectMask = vk::ImageAspectFlagBits::eColor,
+        .layerCount = 1
+      },
+      .imageExtent      = vk::Extent3D{ texture.width, texture.height, 1 }
+    });
+
+    barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+
+    cmd.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader,
+      vk::DependencyFlags(),
+      nullptr,
+      nullptr,
+      barrier
+    );
+
+    texture.pixels.clear();
+    texture.pixels.shrink_to_fit();
+  }
+
+  cmd.end();
+
+  vk::SubmitInfo submit{
+    .commandBufferCount = 1,
+    .pCommandBuffers    = &*cmd
+  };
+
+  vk::raii::Fence fence = std::move(Allocator::fences(engine, 1)[0]);
+
+  engine.m_context.queueFamily(QueueFamilyType::Main).queue.submit(submit, fence);
+
+  if (engine.m_context.device().waitForFences(*fence, true, ge_timeout) != vk::Result::eSuccess)
+    throw std::runtime_error("groot-engine: hung waiting for texture upload");
+}
+
+} // namespace ge
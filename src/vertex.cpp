@@ -2,19 +2,51 @@
 
 #include <__stddef_offsetof.h>
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
 namespace ge {
 
 Vertex::Vertex(vec3 v, vec2 u, vec3 n) : m_position(v), m_uv(u), m_normal(n) {}
 
-vk::VertexInputBindingDescription Vertex::binding() {
+unsigned int Vertex::size(VertexFormat format) {
+  return format == CompactVertices ? sizeof(CompactVertex) : sizeof(Vertex);
+}
+
+vk::VertexInputBindingDescription Vertex::binding(VertexFormat format) {
   return vk::VertexInputBindingDescription{
     .binding    = 0,
-    .stride     = sizeof(Vertex),
+    .stride     = size(format),
     .inputRate  = vk::VertexInputRate::eVertex
   };
 }
 
-std::array<vk::VertexInputAttributeDescription, 3> Vertex::attributes() {
+std::array<vk::VertexInputAttributeDescription, 3> Vertex::attributes(VertexFormat format) {
+  if (format == CompactVertices) {
+    return std::array<vk::VertexInputAttributeDescription, 3>{
+      vk::VertexInputAttributeDescription{
+        .location = 0,
+        .binding  = 0,
+        .format   = vk::Format::eR32G32B32Sfloat,
+        .offset   = offsetof(CompactVertex, position)
+      },
+      vk::VertexInputAttributeDescription{
+        .location = 1,
+        .binding  = 0,
+        .format   = vk::Format::eR16G16Sfloat,
+        .offset   = offsetof(CompactVertex, uv)
+      },
+      vk::VertexInputAttributeDescription{
+        .location = 2,
+        .binding  = 0,
+        .format   = vk::Format::eR16G16Snorm,
+        .offset   = offsetof(CompactVertex, normal)
+      }
+    };
+  }
+
   return std::array<vk::VertexInputAttributeDescription, 3>{
     vk::VertexInputAttributeDescription{
       .location = 0,
@@ -37,8 +69,116 @@ std::array<vk::VertexInputAttributeDescription, 3> Vertex::attributes() {
   };
 }
 
+void Vertex::pack(VertexFormat format, const Vertex * vertices, unsigned int count, void * dst) {
+  if (format == StandardVertices) {
+    memcpy(dst, vertices, count * sizeof(Vertex));
+    return;
+  }
+
+  CompactVertex * compact = reinterpret_cast<CompactVertex *>(dst);
+  for (unsigned int i = 0; i < count; ++i)
+    compact[i] = CompactVertex(vertices[i]);
+}
+
+std::vector<char> Vertex::pack(VertexFormat format, const std::vector<Vertex>& vertices) {
+  std::vector<char> buffer(vertices.size() * size(format));
+  pack(format, vertices.data(), vertices.size(), buffer.data());
+  return buffer;
+}
+
 bool Vertex::operator==(const Vertex& rhs) const {
   return m_position == rhs.m_position && m_uv == rhs.m_uv && m_normal == rhs.m_normal;
 }
 
-} // namespace ge
\ No newline at end of file
+CompactVertex::CompactVertex(const Vertex& vertex) {
+  position[0] = vertex.m_position.x;
+  position[1] = vertex.m_position.y;
+  position[2] = vertex.m_position.z;
+
+  uv[0] = half(vertex.m_uv.x);
+  uv[1] = half(vertex.m_uv.y);
+
+  auto [nx, ny] = octahedral(vertex.m_normal);
+  normal[0] = nx;
+  normal[1] = ny;
+}
+
+unsigned short CompactVertex::half(float value) {
+  unsigned int bits = std::bit_cast<unsigned int>(value);
+  unsigned int sign = (bits >> 16) & 0x8000;
+  int exponent = static_cast<int>((bits >> 23) & 0xff) - 127 + 15;
+  unsigned int mantissa = bits & 0x7fffff;
+
+  if (((bits >> 23) & 0xff) == 0xff)
+    return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+
+  if (exponent >= 0x1f)
+    return sign | 0x7c00;
+
+  if (exponent <= 0) {
+    if (exponent < -10) return sign;
+
+    mantissa |= 0x800000;
+    unsigned int shift = 14 - exponent;
+    unsigned int rounded = (mantissa + (1 << (shift - 1))) >> shift;
+    return sign | rounded;
+  }
+
+  unsigned int rounded = (exponent << 10) | (mantissa >> 13);
+  if (mantissa & 0x1000) ++rounded;
+
+  return sign | std::min(rounded, 0x7c00u);
+}
+
+float CompactVertex::fromHalf(unsigned short value) {
+  unsigned int sign = (value & 0x8000) << 16;
+  unsigned int exponent = (value >> 10) & 0x1f;
+  unsigned int mantissa = value & 0x3ff;
+
+  if (exponent == 0x1f)
+    return std::bit_cast<float>(sign | 0x7f800000 | (mantissa << 13));
+
+  if (exponent == 0) {
+    float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign ? -magnitude : magnitude;
+  }
+
+  return std::bit_cast<float>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+}
+
+std::array<short, 2> CompactVertex::octahedral(const vec3& n) {
+  float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+  if (l1 == 0.0f) return { 0, 0 };
+
+  float x = n.x / l1;
+  float y = n.y / l1;
+
+  if (n.z < 0.0f) {
+    float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    x = fx;
+    y = fy;
+  }
+
+  return {
+    static_cast<short>(std::round(std::clamp(x, -1.0f, 1.0f) * 32767.0f)),
+    static_cast<short>(std::round(std::clamp(y, -1.0f, 1.0f) * 32767.0f))
+  };
+}
+
+vec3 CompactVertex::fromOctahedral(const std::array<short, 2>& encoded) {
+  float x = std::max(encoded[0] / 32767.0f, -1.0f);
+  float y = std::max(encoded[1] / 32767.0f, -1.0f);
+  float z = 1.0f - std::abs(x) - std::abs(y);
+
+  if (z < 0.0f) {
+    float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    x = fx;
+    y = fy;
+  }
+
+  return vec3(x, y, z).normalized();
+}
+
+} // namespace ge
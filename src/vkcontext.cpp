@@ -28,21 +28,28 @@ const QueueFamily& VulkanContext::queueFamily(QueueFamilyType type) const {
   return m_queueFamilies.at(QueueFamilyType::Main);
 }
 
+bool VulkanContext::pipelineLibraries() const {
+  return m_pipelineLibraries;
+}
+
+bool VulkanContext::headlessSurface() const {
+  return m_headlessSurface;
+}
+
 void VulkanContext::initialize(const Engine& engine) {
-  if (*engine.m_surface == nullptr) {
+  if (*m_instance == nullptr) {
     createInstance(engine);
     return;
   }
 
-  if (*m_instance == nullptr)
-    throw std::runtime_error("groot-engine: tried to initialize vulkan objects without establishing vulkan instance");
-
   std::vector<const char *> extensions{
-    VK_KHR_SWAPCHAIN_EXTENSION_NAME,
     VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
     VK_KHR_SHADER_DRAW_PARAMETERS_EXTENSION_NAME
   };
 
+  if (*engine.m_surface != nullptr)
+    extensions.emplace_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
   chooseGPU(engine, extensions);
   createDevice(engine, extensions);
 
@@ -59,31 +66,53 @@ void VulkanContext::createInstance(const Engine& engine) {
     .apiVersion         = ge_vulkan_version
   };
 
-  const char * validationLayer = "VK_LAYER_KHRONOS_validation";
+  vk::raii::Context context;
 
-  unsigned int extensionCount = 0;
-  const char ** glfwExtensions = glfwGetRequiredInstanceExtensions(&extensionCount);
-  if (glfwExtensions == nullptr)
-    throw std::runtime_error("groot-engine: failed to get glfw extensions");
+  // headless machines such as CI runners often ship without the validation layers
+  std::vector<const char *> layers;
+  for (const auto& layer : context.enumerateInstanceLayerProperties()) {
+    if (std::string(layer.layerName) != "VK_LAYER_KHRONOS_validation") continue;
 
-  std::vector<const char *> extensions(glfwExtensions, glfwExtensions + extensionCount);
+    layers.emplace_back("VK_LAYER_KHRONOS_validation");
+    break;
+  }
 
-  vk::InstanceCreateFlags flags;
-  for (const auto& extension : vk::enumerateInstanceExtensionProperties()) {
-    if (std::string(extension.extensionName) != VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME) continue;
+  std::vector<const char *> extensions;
+  if (!engine.m_settings.headless) {
+    unsigned int extensionCount = 0;
+    const char ** glfwExtensions = glfwGetRequiredInstanceExtensions(&extensionCount);
+    if (glfwExtensions == nullptr)
+      throw std::runtime_error("groot-engine: failed to get glfw extensions");
 
+    extensions.assign(glfwExtensions, glfwExtensions + extensionCount);
+  }
+
+  std::set<std::string> available;
+  for (const auto& extension : context.enumerateInstanceExtensionProperties())
+    available.emplace(extension.extensionName);
+
+  vk::InstanceCreateFlags flags;
+  if (available.contains(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME)) {
     extensions.emplace_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
     extensions.emplace_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
     flags |= vk::InstanceCreateFlagBits::eEnumeratePortabilityKHR;
+  }
 
-    break;
+  m_headlessSurface = engine.m_settings.headless &&
+                      engine.m_settings.headless_surface &&
+                      available.contains(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME) &&
+                      available.contains(VK_KHR_SURFACE_EXTENSION_NAME);
+
+  if (m_headlessSurface) {
+    extensions.emplace_back(VK_KHR_SURFACE_EXTENSION_NAME);
+    extensions.emplace_back(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME);
   }
 
-  m_instance = vk::raii::Context().createInstance(vk::InstanceCreateInfo{
+  m_instance = context.createInstance(vk::InstanceCreateInfo{
     .flags                    = flags,
     .pApplicationInfo         = &appInfo,
-    .enabledLayerCount        = 1,
-    .ppEnabledLayerNames      = &validationLayer,
+    .enabledLayerCount        = static_cast<unsigned int>(layers.size()),
+    .ppEnabledLayerNames      = layers.data(),
     .enabledExtensionCount    = static_cast<unsigned int>(extensions.size()),
     .ppEnabledExtensionNames  = extensions.data()
   });
@@ -127,6 +156,32 @@ void VulkanContext::chooseGPU(const Engine& engine, const std::vector<const char
     supported = false;
   }
 
+  auto features2 = m_gpu.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+  const vk::PhysicalDeviceVulkan12Features& vulkan12 = features2.get<vk::PhysicalDeviceVulkan12Features>();
+
+  if (
+    engine.m_settings.culling_mode == GPUCulling ||
+    engine.m_settings.culling_mode == OcclusionCulling ||
+    engine.m_settings.culling_mode == ClusterCulling
+  ) {
+    if (!vulkan12.drawIndirectCount) {
+      reasons.emplace_back("\t- draw indirect count feature not supported");
+      supported = false;
+    }
+  }
+
+  if (
+    !vulkan12.runtimeDescriptorArray ||
+    !vulkan12.shaderSampledImageArrayNonUniformIndexing ||
+    !vulkan12.descriptorBindingPartiallyBound ||
+    !vulkan12.descriptorBindingVariableDescriptorCount ||
+    !vulkan12.descriptorBindingSampledImageUpdateAfterBind ||
+    !vulkan12.descriptorBindingUpdateUnusedWhilePending
+  ) {
+    reasons.emplace_back("\t- descriptor indexing features not supported");
+    supported = false;
+  }
+
   if (!supported) {
     std::string error = "groot-engine: gpu " + std::to_string(engine.m_settings.gpu_index) + " not suitable:\n";
     for (const auto& reason : reasons)
@@ -146,7 +201,7 @@ void VulkanContext::getQueueFamilies(const Engine& engine) {
 
     if ((property.queueFlags & static_cast<vk::QueueFlagBits>(QueueFamilyType::Main))
           && !m_queueFamilies.contains(QueueFamilyType::Main)
-          && m_gpu.getSurfaceSupportKHR(index, engine.m_surface)
+          && (*engine.m_surface == nullptr || m_gpu.getSurfaceSupportKHR(index, engine.m_surface))
     ) {
       m_queueFamilies.emplace(QueueFamilyType::Main, QueueFamily{ .index = index++ });
       continue;
@@ -188,11 +243,28 @@ void VulkanContext::createDevice(const Engine& engine, std::vector<const char *>
     });
   }
 
-  for (const auto& extension : m_gpu.enumerateDeviceExtensionProperties()) {
-    if (std::string(extension.extensionName) != VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME) continue;
+  std::set<std::string> available;
+  for (const auto& extension : m_gpu.enumerateDeviceExtensionProperties())
+    available.emplace(extension.extensionName);
 
+  if (available.contains(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME))
     extensions.emplace_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
-    break;
+
+  m_pipelineLibraries = engine.m_settings.pipeline_libraries &&
+                        available.contains(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+                        available.contains(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+  if (m_pipelineLibraries) {
+    auto features = m_gpu.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>();
+    auto properties = m_gpu.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceGraphicsPipelineLibraryPropertiesEXT>();
+
+    m_pipelineLibraries = features.get<vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>().graphicsPipelineLibrary &&
+                          properties.get<vk::PhysicalDeviceGraphicsPipelineLibraryPropertiesEXT>().graphicsPipelineLibraryFastLinking;
+  }
+
+  if (m_pipelineLibraries) {
+    extensions.emplace_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+    extensions.emplace_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
   }
 
   vk::PhysicalDeviceFeatures features{
@@ -204,8 +276,26 @@ void VulkanContext::createDevice(const Engine& engine, std::vector<const char *>
     .dynamicRendering = vk::True
   };
 
-  vk::DeviceCreateInfo ci_device{
+  vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipelineLibrary{
     .pNext                    = &dynRender,
+    .graphicsPipelineLibrary  = vk::True
+  };
+
+  vk::PhysicalDeviceVulkan12Features vulkan12{
+    .pNext                                        = m_pipelineLibraries ? static_cast<void *>(&pipelineLibrary) : &dynRender,
+    .drawIndirectCount                            = engine.m_settings.culling_mode == GPUCulling ||
+                                                    engine.m_settings.culling_mode == OcclusionCulling ||
+                                                    engine.m_settings.culling_mode == ClusterCulling,
+    .shaderSampledImageArrayNonUniformIndexing    = vk::True,
+    .descriptorBindingSampledImageUpdateAfterBind = vk::True,
+    .descriptorBindingUpdateUnusedWhilePending    = vk::True,
+    .descriptorBindingPartiallyBound              = vk::True,
+    .descriptorBindingVariableDescriptorCount     = vk::True,
+    .runtimeDescriptorArray                       = vk::True
+  };
+
+  vk::DeviceCreateInfo ci_device{
+    .pNext                    = &vulkan12,
     .queueCreateInfoCount     = static_cast<unsigned int>(ci_queues.size()),
     .pQueueCreateInfos        = ci_queues.data(),
     .enabledExtensionCount    = static_cast<unsigned int>(extensions.size()),
@@ -0,0 +1,87 @@
+#include "src/include/workers.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace ge {
+
+WorkerPool::WorkerPool() : WorkerPool(std::max(std::thread::hardware_concurrency(), 1u) - 1) {}
+
+WorkerPool::WorkerPool(unsigned int workers) {
+  for (unsigned int i = 0; i < workers; ++i)
+    m_threads.emplace_back(&WorkerPool::work, this);
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+
+  for (auto& thread : m_threads)
+    thread.join();
+}
+
+unsigned int WorkerPool::size() const {
+  return m_threads.size() + 1;
+}
+
+// the calling thread takes part, tasks must not call run on the same pool
+void WorkerPool::run(unsigned int count, const Task& task) {
+  if (count == 0) return;
+
+  std::lock_guard runLock(m_runMutex);
+  {
+    std::lock_guard lock(m_mutex);
+    m_task = &task;
+    m_count = count;
+    m_next = 0;
+    m_finished = 0;
+  }
+  m_wake.notify_all();
+
+  execute();
+
+  std::unique_lock lock(m_mutex);
+  m_done.wait(lock, [this]() { return m_finished == m_count; });
+  m_task = nullptr;
+
+  if (m_error)
+    std::rethrow_exception(std::exchange(m_error, nullptr));
+}
+
+void WorkerPool::work() {
+  std::unique_lock lock(m_mutex);
+  while (true) {
+    m_wake.wait(lock, [this]() { return m_stopping || (m_task != nullptr && m_next < m_count); });
+    if (m_stopping) return;
+
+    lock.unlock();
+    execute();
+    lock.lock();
+  }
+}
+
+void WorkerPool::execute() {
+  std::unique_lock lock(m_mutex);
+  while (m_task != nullptr && m_next < m_count) {
+    const Task& task = *m_task;
+    unsigned int index = m_next++;
+    lock.unlock();
+
+    std::exception_ptr error;
+    try {
+      task(index);
+    }
+    catch (...) {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    if (error && !m_error) m_error = error;
+    if (++m_finished == m_count) m_done.notify_all();
+  }
+}
+
+} // namespace ge
@@ -0,0 +1,41 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+
+#include "src/shaders/octahedral.glsl"
+
+layout(set = 0, binding = 0) readonly buffer transforms {
+  layout(row_major) mat4 ge_Models[];
+};
+
+layout(set = 1, binding = 0) uniform camera {
+  layout(row_major) mat4 ge_View;
+  layout(row_major) mat4 ge_Projection;
+  layout(row_major) mat4 ge_ViewProjection;
+  layout(row_major) mat4 ge_InverseView;
+  layout(row_major) mat4 ge_InverseProjection;
+  layout(row_major) mat4 ge_InverseViewProjection;
+  vec4 ge_CameraPosition;
+};
+
+layout(push_constant) uniform push_constants {
+  uint ge_Frame;
+  uint ge_Material;
+  uint ge_Transform;
+};
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 uv_in;
+layout(location = 2) in vec2 normal_in;
+
+layout(location = 0) out vec2 uv_out;
+layout(location = 1) out vec3 normal_out;
+layout(location = 2) flat out uint transform_out;
+
+void main() {
+  uint transform_index = ge_Transform + gl_BaseInstance;
+
+  gl_Position = ge_ViewProjection * ge_Models[transform_index] * vec4(position, 1.0);
+  uv_out = uv_in;
+  normal_out = octDecode(normal_in);
+  transform_out = transform_index;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#version 460
+
+struct Vertex {
+  vec3 position;
+  vec2 uv;
+  vec3 normal;
+};
+
+layout(set = 0, binding = 0) readonly buffer transforms {
+  layout(row_major) mat4 ge_Models[];
+};
+
+layout(set = 2, binding = 0) readonly buffer vertices {
+  Vertex ge_Vertices[];
+};
+
+layout(set = 1, binding = 0) uniform camera {
+  layout(row_major) mat4 ge_View;
+  layout(row_major) mat4 ge_Projection;
+  layout(row_major) mat4 ge_ViewProjection;
+  layout(row_major) mat4 ge_InverseView;
+  layout(row_major) mat4 ge_InverseProjection;
+  layout(row_major) mat4 ge_InverseViewProjection;
+  vec4 ge_CameraPosition;
+};
+
+layout(push_constant) uniform push_constants {
+  uint ge_Frame;
+  uint ge_Material;
+  uint ge_Transform;
+};
+
+layout(location = 0) out vec2 uv_out;
+layout(location = 1) out vec3 normal_out;
+layout(location = 2) flat out uint transform_out;
+
+void main() {
+  uint transform_index = ge_Transform + gl_BaseInstance;
+  Vertex vertex = ge_Vertices[gl_VertexIndex];
+
+  gl_Position = ge_ViewProjection * ge_Models[transform_index] * vec4(vertex.position, 1.0);
+  uv_out = vertex.uv;
+  normal_out = vertex.normal;
+  transform_out = transform_index;
+}
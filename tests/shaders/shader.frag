@@ -1,18 +1,57 @@
 #version 460
 
+#extension GL_EXT_nonuniform_qualifier : require
+
+struct MaterialData {
+  uint textures[4];
+  uint samplers[4];
+};
+
+layout(set = 0, binding = 2) readonly buffer materials {
+  MaterialData ge_Materials[];
+};
+
+// parameter components are stored column by column: material column c at
+// c * ge_MaterialStride + ge_Material, object column c at
+// ge_ObjectOffset + c * ge_ObjectStride + transform index
+layout(set = 0, binding = 3) readonly buffer parameters {
+  uint ge_MaterialStride;
+  uint ge_ObjectStride;
+  uint ge_ObjectOffset;
+  uint ge_Parameters[];
+};
+
+layout(set = 0, binding = 4) uniform sampler ge_Samplers[4];
+layout(set = 0, binding = 5) uniform texture2D ge_Textures[];
+
 layout(push_constant) uniform push_constants {
-  layout(row_major) mat4 ge_View;
-  layout(row_major) mat4 ge_Projection;
   uint ge_Frame;
   uint ge_Material;
   uint ge_Transform;
 };
 
+layout(constant_id = 0) const float blue = 0.0;
+
 layout(location = 0) in vec2 uv;
 layout(location = 1) in vec3 normal;
+layout(location = 2) flat in uint transform_index;
 
 layout(location = 0) out vec4 frag_color;
 
+float materialParameter(uint column) {
+  return uintBitsToFloat(ge_Parameters[column * ge_MaterialStride + ge_Material]);
+}
+
+float objectParameter(uint column) {
+  return uintBitsToFloat(ge_Parameters[ge_ObjectOffset + column * ge_ObjectStride + transform_index]);
+}
+
 void main() {
-  frag_color = vec4(uv, 0.0, 1.0);
-}
\ No newline at end of file
+  MaterialData material = ge_Materials[ge_Material];
+  vec4 texel = texture(sampler2D(ge_Textures[nonuniformEXT(material.textures[0])], ge_Samplers[material.samplers[0]]), uv);
+
+  vec3 tint = vec3(materialParameter(0), materialParameter(1), materialParameter(2));
+  float brightness = objectParameter(0);
+
+  frag_color = vec4(uv, blue, 1.0) * texel * vec4(tint * brightness, 1.0);
+}
@@ -4,9 +4,17 @@ layout(set = 0, binding = 0) readonly buffer transforms {
   layout(row_major) mat4 ge_Models[];
 };
 
-layout(push_constant) uniform push_constants {
+layout(set = 1, binding = 0) uniform camera {
   layout(row_major) mat4 ge_View;
   layout(row_major) mat4 ge_Projection;
+  layout(row_major) mat4 ge_ViewProjection;
+  layout(row_major) mat4 ge_InverseView;
+  layout(row_major) mat4 ge_InverseProjection;
+  layout(row_major) mat4 ge_InverseViewProjection;
+  vec4 ge_CameraPosition;
+};
+
+layout(push_constant) uniform push_constants {
   uint ge_Frame;
   uint ge_Material;
   uint ge_Transform;
@@ -18,11 +26,13 @@ layout(location = 2) in vec3 normal_in;
 
 layout(location = 0) out vec2 uv_out;
 layout(location = 1) out vec3 normal_out;
+layout(location = 2) flat out uint transform_out;
 
 void main() {
   uint transform_index = ge_Transform + gl_BaseInstance;
 
-  gl_Position = ge_Projection * ge_View * ge_Models[transform_index] * vec4(position, 1.0);
+  gl_Position = ge_ViewProjection * ge_Models[transform_index] * vec4(position, 1.0);
   uv_out = uv_in;
   normal_out = normal_in;
+  transform_out = transform_index;
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "src/include/bounds.hpp"
+#include "src/include/parsers.hpp"
+#include "tests/utility.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+TEST_CASE( "bounds", "[unit][bounds]" ) {
+  auto [vertices, indices] = ge::ObjParser::parse("../tests/dat/quad.obj");
+  ge::Bounds bounds = ge::Bounds::compute(vertices);
+
+  SECTION( "compute" ) {
+    CHECK( tests::error(bounds.min, ge::vec3(-0.5f, -0.5f, 0.0f)) <= tests::g_absTolerance );
+    CHECK( tests::error(bounds.max, ge::vec3(0.5f, 0.5f, 0.0f)) <= tests::g_absTolerance );
+    CHECK( tests::error(bounds.center, ge::vec3(0.0f)) <= tests::g_absTolerance );
+    CHECK( tests::error(bounds.radius, std::sqrt(0.5f)) <= tests::tolerance(std::sqrt(0.5f)) );
+  }
+
+  SECTION( "transformed" ) {
+    ge::Bounds world = bounds.transformed(
+      ge::mat4::translation(ge::vec3(1.0f, 2.0f, 3.0f)) * ge::mat4::scale(ge::vec3(2.0f, 1.0f, 1.0f))
+    );
+
+    CHECK( tests::error(world.min, ge::vec3(0.0f, 1.5f, 3.0f)) <= tests::tolerance(world.min) );
+    CHECK( tests::error(world.max, ge::vec3(2.0f, 2.5f, 3.0f)) <= tests::tolerance(world.max) );
+    CHECK( tests::error(world.center, ge::vec3(1.0f, 2.0f, 3.0f)) <= tests::tolerance(world.center) );
+    CHECK( tests::error(world.radius, 2.0f * std::sqrt(0.5f)) <= tests::tolerance(world.radius) );
+  }
+
+  SECTION( "array" ) {
+    ge::BoundsArray array;
+    array.resize(3);
+    array.set(1, bounds);
+
+    CHECK( array.size() == 3 );
+    CHECK( array.component(ge::Radius)[1] == bounds.radius );
+    CHECK( array.component(ge::MaxX)[1] == bounds.max.x );
+    CHECK( array[1].min == bounds.min );
+  }
+}
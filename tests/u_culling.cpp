@@ -0,0 +1,44 @@
+#include "src/include/culling.hpp"
+#include "tests/utility.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <numbers>
+#include <vector>
+
+TEST_CASE( "frustum", "[unit][culling]" ) {
+  ge::Frustum frustum(
+    ge::mat4::perspective(std::numbers::pi / 3.0f, 16.0f / 9.0f, 0.01f, 1000.0f) *
+    ge::mat4::view(ge::vec3(0.0f, 0.0f, -2.0f), ge::vec3(0.0f), ge::vec3(0.0f, -1.0f, 0.0f))
+  );
+
+  SECTION( "intersects" ) {
+    CHECK( frustum.intersects(ge::Bounds(ge::vec3(-1.0f), ge::vec3(1.0f))) );
+    CHECK( !frustum.intersects(ge::Bounds(ge::vec3(-1.0f, -1.0f, -10.0f), ge::vec3(1.0f, 1.0f, -8.0f))) );
+    CHECK( !frustum.intersects(ge::Bounds(ge::vec3(50.0f, -1.0f, 1.0f), ge::vec3(52.0f, 1.0f, 2.0f))) );
+    CHECK( !frustum.intersects(ge::Bounds(ge::vec3(-1.0f, -1.0f, 2000.0f), ge::vec3(1.0f, 1.0f, 2001.0f))) );
+  }
+
+  SECTION( "cull" ) {
+    tests::Random random;
+
+    const unsigned int count = 1003;
+    ge::BoundsArray bounds;
+    bounds.resize(count);
+
+    for (unsigned int i = 0; i < count; ++i) {
+      ge::vec3 center(random(), random(), random());
+      bounds.set(i, ge::Bounds(center - ge::vec3(1.0f), center + ge::vec3(1.0f)));
+    }
+
+    std::vector<unsigned char> visible(count, 2);
+    frustum.cull(bounds, 0, count, visible.data());
+
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < count; ++i) {
+      if (visible[i] != static_cast<unsigned char>(frustum.intersects(bounds[i])))
+        ++mismatches;
+    }
+    CHECK( mismatches == 0 );
+  }
+}
@@ -2,6 +2,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <cmath>
+#include <filesystem>
+
 TEST_CASE( "engine", "[unit][engine]" ) {
   ge::Engine engine;
 
@@ -19,6 +22,38 @@ TEST_CASE( "engine", "[unit][engine]" ) {
     CHECK( caught );
   }
 
+  SECTION( "add_duplicate_texture" ) {
+    engine.add_texture("test", 1, 1, { 255, 255, 255, 255 });
+
+    bool caught = false;
+    try {
+      engine.add_texture("test", 1, 1, { 255, 255, 255, 255 });
+    }
+    catch (const std::runtime_error& e) {
+      caught = true;
+      CHECK( e.what() == std::string("groot-engine: texture 'test' already exists") );
+    }
+    CHECK( caught );
+  }
+
+  SECTION( "parameter_type_mismatch" ) {
+    engine.add_material("test", ge::MaterialManager::Builder()
+      .set_parameter("tint", ge::vec3(1.0f))
+      .set_object_parameter("brightness", 1.0f)
+    );
+    ge::transform obj = engine.add_object("test", "../tests/dat/quad.obj");
+
+    bool caught = false;
+    try {
+      engine.set_parameter(obj, "brightness", 1);
+    }
+    catch (const std::runtime_error& e) {
+      caught = true;
+      CHECK( e.what() == std::string("groot-engine: parameter 'brightness' of material 'test' has a different type") );
+    }
+    CHECK( caught );
+  }
+
   SECTION( "object_with_invalid_material" ) {
     bool caught = false;
     try {
@@ -31,10 +66,43 @@ TEST_CASE( "engine", "[unit][engine]" ) {
     CHECK( caught );
   }
 
+  SECTION( "update_static_object" ) {
+    engine.add_material("test", ge::MaterialManager::Builder());
+    ge::transform obj = engine.add_object("test", "../tests/dat/quad.obj");
+
+    bool caught = false;
+    try {
+      engine.update_vertices(obj, 0, {});
+    }
+    catch (const std::runtime_error& e) {
+      caught = true;
+      CHECK( e.what() == std::string("groot-engine: object is not dynamic") );
+    }
+    CHECK( caught );
+  }
+
+  SECTION( "optimization_report" ) {
+    engine.add_material("test", ge::MaterialManager::Builder());
+    ge::transform obj = engine.add_object("test", "../tests/dat/circle.obj");
+
+    ge::OptimizationReport report = engine.optimization_report(obj);
+    CHECK( report.acmrBefore > 0.0f );
+    CHECK( report.acmrAfter > 0.0f );
+    CHECK( report.acmrAfter <= report.acmrBefore );
+  }
+
   SECTION( "full_test" ) {
+    engine.add_texture("checker", 2, 2, {
+      255, 255, 255, 255,   64,  64,  64, 255,
+       64,  64,  64, 255,  255, 255, 255, 255
+    });
+
     engine.add_material("test", ge::MaterialManager::Builder()
       .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
       .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+      .add_texture("checker", ge::NearestRepeat)
+      .set_parameter("tint", ge::vec3(1.0f, 0.9f, 0.8f))
+      .set_object_parameter("brightness", 1.0f)
     );
 
     ge::transform obj1 = engine.add_object("test", "../tests/dat/circle.obj",
@@ -48,14 +116,39 @@ TEST_CASE( "engine", "[unit][engine]" ) {
     ge::transform obj3 = engine.add_object("test", "../tests/dat/pentagon.obj",
       ge::Transform(ge::vec3(3.0f, 0.0f, 2.0f), ge::vec3(0.0f), ge::vec3(0.74f))
     );
+    engine.set_parameter(obj3, "brightness", 0.5f);
+
+    engine.add_material("pulled", ge::MaterialManager::Builder()
+      .add_shader(ge::ShaderStage::VertexShader, "shaders/pull.vert.spv")
+      .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+      .set_vertex_pulling()
+      .set_constant(ge::ShaderStage::FragmentShader, 0, 0.5f)
+      .set_parameter("tint", ge::vec3(1.0f))
+      .set_object_parameter("brightness", 1.0f)
+    );
+
+    engine.add_object("pulled", "../tests/dat/quad.obj",
+      ge::Transform(ge::vec3(-2.0f, 0.0f, 3.0f), ge::vec3(0.0f), ge::vec3(0.5f))
+    );
 
     float w = 0.05;
     float a = 1.5f;
     float av = ge::radians(40.0f);
 
+    bool added = false;
     bool success = true;
     try {
-      engine.run([&obj1, &obj2, &obj3, &w, &a, &av](double dt) {
+      engine.run([&engine, &added, &obj1, &obj2, &obj3, &w, &a, &av](double dt) {
+        if (!added) {
+          engine.add_material("runtime", ge::MaterialManager::Builder()
+            .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
+            .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+            .set_blend_mode(ge::AlphaBlending)
+            .set_parameter("tint", ge::vec3(1.0f))
+          );
+          added = true;
+        }
+
         float x1 = w * a * std::cos(w * obj1->elapsed_time()) * dt;
         float z1 = w * a * std::sin(w * obj1->elapsed_time()) * dt;
 
@@ -65,6 +158,8 @@ TEST_CASE( "engine", "[unit][engine]" ) {
         float y3 = w * a * std::cos(w * obj3->elapsed_time()) * dt;
         float z3 = w * a * std::sin(w * obj3->elapsed_time()) * dt;
 
+        engine.set_parameter(obj1, "brightness", 0.75f + 0.25f * static_cast<float>(std::cos(obj1->elapsed_time())));
+
         obj1->translate(ge::vec3(x1, 0.0f, z1));
         obj1->rotate(ge::vec3(0.0f, 0.0f, -av * dt));
 
@@ -80,4 +175,304 @@ TEST_CASE( "engine", "[unit][engine]" ) {
     }
     CHECK( success );
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE( "headless_engine", "[unit][engine]" ) {
+  ge::CullingMode mode = ge::NoCulling;
+  bool surface = false;
+
+  SECTION( "no_culling" ) {
+    mode = ge::NoCulling;
+  }
+
+  SECTION( "cpu_culling" ) {
+    mode = ge::CPUCulling;
+  }
+
+  SECTION( "gpu_culling" ) {
+    mode = ge::GPUCulling;
+  }
+
+  SECTION( "occlusion_culling" ) {
+    mode = ge::OcclusionCulling;
+  }
+
+  SECTION( "software_occlusion_culling" ) {
+    mode = ge::SoftwareOcclusionCulling;
+  }
+
+  SECTION( "cluster_culling" ) {
+    mode = ge::ClusterCulling;
+  }
+
+  SECTION( "headless_surface" ) {
+    surface = true;
+  }
+
+  ge::Engine engine(ge::Settings{ .culling_mode = mode, .headless = true, .headless_surface = surface });
+
+  engine.add_material("test", ge::MaterialManager::Builder()
+    .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
+    .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+    .set_parameter("tint", ge::vec3(1.0f))
+    .set_object_parameter("brightness", 1.0f)
+  );
+
+  ge::transform obj = engine.add_object("test", "../tests/dat/quad.obj",
+    ge::Transform(ge::vec3(0.0f, 0.0f, 1.5f), ge::vec3(0.0f), ge::vec3(1.0f))
+  );
+
+  bool success = true;
+  try {
+    for (unsigned int i = 0; i < 8; ++i) {
+      obj->rotate(ge::vec3(0.0f, 0.0f, ge::radians(5.0f)));
+      engine.render_frame();
+    }
+
+    unsigned int frames = 0;
+    engine.run([&engine, &frames]() {
+      if (++frames == 8) engine.close();
+    });
+  }
+  catch (const std::exception&) {
+    success = false;
+  }
+  CHECK( success );
+}
+
+TEST_CASE( "headless_dynamic_object", "[unit][engine]" ) {
+  ge::Engine engine(ge::Settings{ .headless = true });
+
+  engine.add_material("test", ge::MaterialManager::Builder()
+    .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
+    .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+    .set_parameter("tint", ge::vec3(1.0f))
+    .set_object_parameter("brightness", 1.0f)
+  );
+
+  engine.add_object("test", "../tests/dat/quad.obj",
+    ge::Transform(ge::vec3(-0.5f, 0.0f, 2.0f), ge::vec3(0.0f), ge::vec3(1.0f))
+  );
+  ge::transform obj = engine.add_dynamic_object("test", "../tests/dat/quad.obj",
+    ge::Transform(ge::vec3(0.5f, 0.0f, 2.0f), ge::vec3(0.0f), ge::vec3(1.0f))
+  );
+
+  std::vector<ge::Vertex> vertices;
+  bool success = true;
+  try {
+    for (unsigned int i = 0; i < 8; ++i) {
+      float size = 0.25f + 0.05f * static_cast<float>(i);
+      vertices = {
+        ge::Vertex(ge::vec3(-size, -size, 0.0f), ge::vec2(0.0f, 0.0f), ge::vec3(0.0f, 0.0f, -1.0f)),
+        ge::Vertex(ge::vec3(-size, size, 0.0f), ge::vec2(0.0f, 1.0f), ge::vec3(0.0f, 0.0f, -1.0f)),
+        ge::Vertex(ge::vec3(size, size, 0.0f), ge::vec2(1.0f, 1.0f), ge::vec3(0.0f, 0.0f, -1.0f)),
+        ge::Vertex(ge::vec3(size, -size, 0.0f), ge::vec2(1.0f, 0.0f), ge::vec3(0.0f, 0.0f, -1.0f))
+      };
+
+      engine.update_vertices(obj, 0, vertices);
+      engine.render_frame();
+    }
+  }
+  catch (const std::exception&) {
+    success = false;
+  }
+  REQUIRE( success );
+
+  ge::Bounds expected = ge::Bounds::compute(vertices);
+  CHECK( std::abs(engine.bounds(obj).radius - expected.radius) < 1e-5f );
+
+  bool caught = false;
+  try {
+    engine.update_vertices(obj, 2, vertices);
+  }
+  catch (const std::runtime_error& e) {
+    caught = true;
+    CHECK( e.what() == std::string("groot-engine: vertex update out of range") );
+  }
+  CHECK( caught );
+}
+
+TEST_CASE( "headless_compact_vertices", "[unit][engine]" ) {
+  ge::Engine engine(ge::Settings{ .vertex_format = ge::CompactVertices, .headless = true });
+
+  engine.add_material("test", ge::MaterialManager::Builder()
+    .add_shader(ge::ShaderStage::VertexShader, "shaders/compact.vert.spv")
+    .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+    .set_parameter("tint", ge::vec3(1.0f))
+    .set_object_parameter("brightness", 1.0f)
+  );
+
+  engine.add_object("test", "../tests/dat/circle.obj",
+    ge::Transform(ge::vec3(-0.5f, 0.0f, 3.0f), ge::vec3(0.0f), ge::vec3(0.8f))
+  );
+  ge::transform obj = engine.add_dynamic_object("test", "../tests/dat/quad.obj",
+    ge::Transform(ge::vec3(0.5f, 0.0f, 2.0f), ge::vec3(0.0f), ge::vec3(1.0f))
+  );
+
+  bool success = true;
+  try {
+    for (unsigned int i = 0; i < 8; ++i) {
+      obj->rotate(ge::vec3(0.0f, ge::radians(5.0f), 0.0f));
+      engine.render_frame();
+    }
+  }
+  catch (const std::exception&) {
+    success = false;
+  }
+  CHECK( success );
+}
+
+TEST_CASE( "headless_material_limit", "[unit][engine]" ) {
+  ge::Engine engine(ge::Settings{ .headless = true });
+
+  auto builder = []() {
+    return ge::MaterialManager::Builder()
+      .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
+      .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+      .set_parameter("tint", ge::vec3(1.0f))
+      .set_object_parameter("brightness", 1.0f);
+  };
+
+  for (unsigned int i = 0; i < 1024; ++i)
+    engine.add_material("material" + std::to_string(i), builder());
+  engine.render_frame();
+
+  bool caught = false;
+  try {
+    engine.add_material("extra", builder());
+  }
+  catch (const std::runtime_error& e) {
+    caught = true;
+    CHECK( e.what() == std::string("groot-engine: material limit of 1024 reached") );
+  }
+  CHECK( caught );
+
+  bool success = true;
+  try {
+    for (unsigned int i = 0; i < 4; ++i)
+      engine.render_frame();
+  }
+  catch (const std::exception&) {
+    success = false;
+  }
+  CHECK( success );
+}
+
+TEST_CASE( "headless_gpu_culling", "[unit][engine]" ) {
+  ge::Engine engine(ge::Settings{ .culling_mode = ge::GPUCulling, .headless = true });
+
+  engine.add_material("test", ge::MaterialManager::Builder()
+    .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
+    .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+    .set_parameter("tint", ge::vec3(1.0f))
+    .set_object_parameter("brightness", 1.0f)
+  );
+
+  engine.add_object("test", "../tests/dat/quad.obj",
+    ge::Transform(ge::vec3(0.0f, 0.0f, 1.5f), ge::vec3(0.0f), ge::vec3(1.0f))
+  );
+  engine.add_object("test", "../tests/dat/quad.obj",
+    ge::Transform(ge::vec3(0.0f, 0.0f, -4.0f), ge::vec3(0.0f), ge::vec3(1.0f))
+  );
+
+  for (unsigned int i = 0; i < 4; ++i)
+    engine.render_frame();
+
+  ge::CullingStatistics statistics = engine.culling_statistics();
+  CHECK( statistics.commands == 2 );
+  CHECK( statistics.visible[0] == 1 );
+}
+
+TEST_CASE( "headless_occlusion_culling", "[unit][engine]" ) {
+  ge::Engine engine(ge::Settings{ .culling_mode = ge::OcclusionCulling, .headless = true });
+
+  engine.add_material("test", ge::MaterialManager::Builder()
+    .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
+    .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+    .set_cull_mode(vk::CullModeFlagBits::eNone)
+    .set_parameter("tint", ge::vec3(1.0f))
+    .set_object_parameter("brightness", 1.0f)
+  );
+
+  ge::transform occluder = engine.add_object("test", "../tests/dat/quad.obj",
+    ge::Transform(ge::vec3(0.0f), ge::vec3(0.0f), ge::vec3(4.0f))
+  );
+  engine.add_object("test", "../tests/dat/quad.obj",
+    ge::Transform(ge::vec3(0.0f, 0.0f, 3.0f), ge::vec3(0.0f), ge::vec3(1.0f))
+  );
+
+  for (unsigned int i = 0; i < 4; ++i)
+    engine.render_frame();
+
+  ge::CullingStatistics statistics = engine.culling_statistics();
+  CHECK( statistics.commands == 2 );
+  CHECK( statistics.visible[0] == 1 );
+  CHECK( statistics.visible[1] == 0 );
+
+  occluder->translate(ge::vec3(3.0f, 0.0f, 0.0f));
+  for (unsigned int i = 0; i < 4; ++i)
+    engine.render_frame();
+
+  statistics = engine.culling_statistics();
+  CHECK( statistics.visible[0] + statistics.visible[1] == 2 );
+}
+
+TEST_CASE( "headless_cluster_culling", "[unit][engine]" ) {
+  ge::Engine engine(ge::Settings{ .culling_mode = ge::ClusterCulling, .headless = true });
+
+  engine.add_material("test", ge::MaterialManager::Builder()
+    .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
+    .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+    .set_parameter("tint", ge::vec3(1.0f))
+    .set_object_parameter("brightness", 1.0f)
+  );
+
+  engine.add_object("test", "../tests/dat/sphere.obj",
+    ge::Transform(ge::vec3(0.0f, 0.0f, 3.0f), ge::vec3(0.0f), ge::vec3(2.0f))
+  );
+
+  for (unsigned int i = 0; i < 4; ++i)
+    engine.render_frame();
+
+  ge::CullingStatistics statistics = engine.culling_statistics();
+  REQUIRE( statistics.commands > 1 );
+  CHECK( statistics.visible[0] > 0 );
+  CHECK( statistics.visible[0] < statistics.commands );
+}
+
+TEST_CASE( "headless_pipeline_cache", "[unit][engine]" ) {
+  const std::string path = "pipeline_cache_test.bin";
+  std::filesystem::remove(path);
+
+  auto run = [&path]() {
+    ge::Engine engine(ge::Settings{ .pipeline_cache_path = path, .headless = true });
+
+    engine.add_material("test", ge::MaterialManager::Builder()
+      .add_shader(ge::ShaderStage::VertexShader, "shaders/shader.vert.spv")
+      .add_shader(ge::ShaderStage::FragmentShader, "shaders/shader.frag.spv")
+      .set_parameter("tint", ge::vec3(1.0f))
+      .set_object_parameter("brightness", 1.0f)
+    );
+
+    engine.add_object("test", "../tests/dat/quad.obj",
+      ge::Transform(ge::vec3(0.0f, 0.0f, 1.5f), ge::vec3(0.0f), ge::vec3(1.0f))
+    );
+
+    for (unsigned int i = 0; i < 4; ++i)
+      engine.render_frame();
+
+    return engine.pipeline_cache_statistics();
+  };
+
+  ge::PipelineCacheStatistics first = run();
+  CHECK( !first.loaded );
+  CHECK( first.pipelines > 0 );
+  REQUIRE( std::filesystem::exists(path) );
+
+  ge::PipelineCacheStatistics second = run();
+  CHECK( second.loaded );
+  CHECK( second.pipelines > 0 );
+  CHECK( second.hits > 0 );
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,34 @@
+#include "src/include/materials.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+
+TEST_CASE( "parameter_layout", "[unit][materials]" ) {
+  const unsigned int objectStride = 37;
+  std::array<unsigned int, 3> header = ge::MaterialManager::parameterHeader(objectStride);
+
+  REQUIRE( header[0] > 0 );
+  CHECK( header[1] == objectStride );
+
+  // word offsets as read by tests/shaders/shader.frag, ge_Parameters follows the header
+  auto materialParameter = [&header](unsigned int column, unsigned int material) {
+    return static_cast<unsigned int>(header.size()) + column * header[0] + material;
+  };
+  auto objectParameter = [&header](unsigned int column, unsigned int transform) {
+    return static_cast<unsigned int>(header.size()) + header[2] + column * header[1] + transform;
+  };
+
+  for (unsigned int column = 0; column < ge::MaterialManager::max_parameters; ++column) {
+    for (unsigned int material : { 0u, 1u, header[0] - 1 })
+      CHECK( ge::MaterialManager::materialParameter(column, material) == materialParameter(column, material) );
+  }
+
+  for (unsigned int column = 0; column < 4; ++column) {
+    for (unsigned int transform : { 0u, 1u, objectStride - 1 })
+      CHECK( ge::MaterialManager::objectParameter(column, transform, objectStride) == objectParameter(column, transform) );
+  }
+
+  unsigned int lastMaterial = ge::MaterialManager::materialParameter(ge::MaterialManager::max_parameters - 1, header[0] - 1);
+  CHECK( lastMaterial < ge::MaterialManager::objectParameter(0, 0, objectStride) );
+}
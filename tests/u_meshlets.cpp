@@ -0,0 +1,81 @@
+#include "src/include/meshlets.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_CASE( "meshlets", "[unit][meshlets]" ) {
+  const unsigned int size = 33;
+
+  std::vector<ge::Vertex> vertices;
+  for (unsigned int y = 0; y < size; ++y) {
+    for (unsigned int x = 0; x < size; ++x) {
+      vertices.emplace_back(ge::Vertex(
+        ge::vec3(static_cast<float>(x), static_cast<float>(y), 0.0f),
+        ge::vec2(0.0f),
+        ge::vec3(0.0f, 0.0f, 1.0f)
+      ));
+    }
+  }
+
+  std::vector<unsigned int> indices;
+  for (unsigned int y = 0; y + 1 < size; ++y) {
+    for (unsigned int x = 0; x + 1 < size; ++x) {
+      unsigned int i = y * size + x;
+      indices.insert(indices.end(), { i, i + 1, i + size + 1, i, i + size + 1, i + size });
+    }
+  }
+
+  auto [meshlets, output] = ge::MeshletBuilder::build(vertices, indices);
+
+  SECTION( "limits" ) {
+    CHECK( output.size() == indices.size() );
+    CHECK( meshlets.size() >= indices.size() / 3 / ge::MeshletBuilder::max_triangles );
+
+    unsigned int total = 0;
+    for (const auto& meshlet : meshlets) {
+      std::vector<unsigned int> unique(output.begin() + meshlet.firstIndex, output.begin() + meshlet.firstIndex + meshlet.indexCount);
+      std::sort(unique.begin(), unique.end());
+      unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+      CHECK( meshlet.firstIndex == total );
+      CHECK( meshlet.indexCount / 3 <= ge::MeshletBuilder::max_triangles );
+      CHECK( meshlet.vertexCount <= ge::MeshletBuilder::max_vertices );
+      CHECK( meshlet.vertexCount == unique.size() );
+      total += meshlet.indexCount;
+    }
+
+    CHECK( total == output.size() );
+  }
+
+  SECTION( "triangles" ) {
+    auto key = [](unsigned int a, unsigned int b, unsigned int c) {
+      std::vector<unsigned int> t = { a, b, c };
+      std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+      return t;
+    };
+
+    std::vector<std::vector<unsigned int>> expected;
+    std::vector<std::vector<unsigned int>> actual;
+    for (unsigned int i = 0; i < indices.size(); i += 3) {
+      expected.emplace_back(key(indices[i], indices[i + 1], indices[i + 2]));
+      actual.emplace_back(key(output[i], output[i + 1], output[i + 2]));
+    }
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    CHECK( expected == actual );
+  }
+
+  SECTION( "bounds" ) {
+    for (const auto& meshlet : meshlets) {
+      for (unsigned int i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; ++i)
+        CHECK( (vertices[output[i]].m_position - meshlet.bounds.center).magnitude() <= meshlet.bounds.radius + 1e-4f );
+
+      CHECK( std::abs(meshlet.coneAxis.z - 1.0f) < 1e-4f );
+      CHECK( meshlet.coneCutoff < 1e-3f );
+    }
+  }
+}
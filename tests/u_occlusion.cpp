@@ -0,0 +1,64 @@
+#include "src/include/occlusion.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <numbers>
+#include <vector>
+
+TEST_CASE( "occlusion", "[unit][occlusion]" ) {
+  ge::mat4 viewProjection =
+    ge::mat4::perspective(std::numbers::pi / 3.0f, 16.0f / 9.0f, 0.01f, 1000.0f) *
+    ge::mat4::view(ge::vec3(0.0f, 0.0f, -2.0f), ge::vec3(0.0f), ge::vec3(0.0f, -1.0f, 0.0f));
+
+  std::vector<ge::Vertex> vertices = {
+    ge::Vertex(ge::vec3(-5.0f, -5.0f, 0.0f), ge::vec2(0.0f), ge::vec3(0.0f, 0.0f, -1.0f)),
+    ge::Vertex(ge::vec3(5.0f, -5.0f, 0.0f), ge::vec2(0.0f), ge::vec3(0.0f, 0.0f, -1.0f)),
+    ge::Vertex(ge::vec3(5.0f, 5.0f, 0.0f), ge::vec2(0.0f), ge::vec3(0.0f, 0.0f, -1.0f)),
+    ge::Vertex(ge::vec3(-5.0f, 5.0f, 0.0f), ge::vec2(0.0f), ge::vec3(0.0f, 0.0f, -1.0f))
+  };
+  std::vector<unsigned int> indices = { 0, 1, 2, 0, 2, 3 };
+
+  ge::OcclusionBuffer buffer(250, 125);
+  ge::WorkerPool workers;
+
+  SECTION( "resize" ) {
+    CHECK( buffer.width() == 256 );
+    CHECK( buffer.height() == 128 );
+  }
+
+  SECTION( "empty" ) {
+    buffer.render(viewProjection, {}, workers);
+
+    CHECK( buffer.depth(128, 64) == 1.0f );
+    CHECK( buffer.visible(ge::Bounds(ge::vec3(-0.5f, -0.5f, 5.0f), ge::vec3(0.5f, 0.5f, 6.0f))) );
+  }
+
+  SECTION( "occluder" ) {
+    buffer.render(viewProjection, {
+      ge::Occluder{
+        .vertices   = vertices.data(),
+        .indices    = indices.data(),
+        .indexCount = static_cast<unsigned int>(indices.size())
+      }
+    }, workers);
+
+    CHECK( buffer.depth(128, 64) < 1.0f );
+    CHECK( !buffer.visible(ge::Bounds(ge::vec3(-0.5f, -0.5f, 5.0f), ge::vec3(0.5f, 0.5f, 6.0f))) );
+    CHECK( !buffer.visible(ge::Bounds(ge::vec3(2.0f, 2.0f, 3.0f), ge::vec3(3.0f, 3.0f, 4.0f))) );
+    CHECK( buffer.visible(ge::Bounds(ge::vec3(-0.5f, -0.5f, -1.0f), ge::vec3(0.5f, 0.5f, -0.5f))) );
+    CHECK( buffer.visible(ge::Bounds(ge::vec3(-0.5f, -0.5f, -0.5f), ge::vec3(0.5f, 0.5f, 0.5f))) );
+  }
+
+  SECTION( "near_clipped_occluder" ) {
+    buffer.render(viewProjection, {
+      ge::Occluder{
+        .transform  = ge::mat4::translation(ge::vec3(0.0f, 0.0f, -2.0f)) * ge::mat4::scale(ge::vec3(10.0f)),
+        .vertices   = vertices.data(),
+        .indices    = indices.data(),
+        .indexCount = static_cast<unsigned int>(indices.size())
+      }
+    }, workers);
+
+    CHECK( buffer.visible(ge::Bounds(ge::vec3(-0.5f, -0.5f, 5.0f), ge::vec3(0.5f, 0.5f, 6.0f))) );
+  }
+}
@@ -0,0 +1,85 @@
+#include "src/include/optimizer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+TEST_CASE( "optimizer", "[unit][optimizer]" ) {
+  const unsigned int size = 33;
+
+  std::vector<ge::Vertex> vertices;
+  for (unsigned int y = 0; y < size; ++y) {
+    for (unsigned int x = 0; x < size; ++x) {
+      vertices.emplace_back(ge::Vertex(
+        ge::vec3(static_cast<float>(x), static_cast<float>(y), 0.0f),
+        ge::vec2(static_cast<float>(x), static_cast<float>(y)),
+        ge::vec3(0.0f, 0.0f, 1.0f)
+      ));
+    }
+  }
+
+  std::vector<std::array<unsigned int, 3>> triangles;
+  for (unsigned int y = 0; y + 1 < size; ++y) {
+    for (unsigned int x = 0; x + 1 < size; ++x) {
+      unsigned int i = y * size + x;
+      triangles.push_back({ i, i + 1, i + size + 1 });
+      triangles.push_back({ i, i + size + 1, i + size });
+    }
+  }
+
+  std::shuffle(triangles.begin(), triangles.end(), std::mt19937(7));
+
+  std::vector<unsigned int> indices;
+  for (const auto& t : triangles)
+    indices.insert(indices.end(), t.begin(), t.end());
+
+  auto sorted = [](const std::vector<ge::Vertex>& vs, const std::vector<unsigned int>& is) {
+    std::vector<std::array<float, 6>> out;
+    for (unsigned int i = 0; i < is.size(); i += 3) {
+      std::array<std::array<float, 2>, 3> t = {{
+        { vs[is[i]].m_uv.x, vs[is[i]].m_uv.y },
+        { vs[is[i + 1]].m_uv.x, vs[is[i + 1]].m_uv.y },
+        { vs[is[i + 2]].m_uv.x, vs[is[i + 2]].m_uv.y }
+      }};
+      std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+      out.push_back({ t[0][0], t[0][1], t[1][0], t[1][1], t[2][0], t[2][1] });
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+  };
+
+  SECTION( "acmr" ) {
+    CHECK( ge::MeshOptimizer::acmr({ 0, 1, 2, 0, 2, 3 }, 4) == 2.0f );
+  }
+
+  SECTION( "vertex_cache" ) {
+    std::vector<unsigned int> optimized = ge::MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+
+    CHECK( optimized.size() == indices.size() );
+    CHECK( sorted(vertices, optimized) == sorted(vertices, indices) );
+    CHECK( ge::MeshOptimizer::acmr(optimized, vertices.size()) < 0.8f );
+    CHECK( ge::MeshOptimizer::acmr(indices, vertices.size()) > 1.5f );
+  }
+
+  SECTION( "optimize" ) {
+    std::vector<ge::Vertex> optimizedVertices = vertices;
+    std::vector<unsigned int> optimizedIndices = indices;
+
+    ge::OptimizationReport report = ge::MeshOptimizer::optimize(optimizedVertices, optimizedIndices);
+
+    CHECK( report.acmrAfter < report.acmrBefore );
+    CHECK( optimizedVertices.size() == vertices.size() );
+    CHECK( sorted(optimizedVertices, optimizedIndices) == sorted(vertices, indices) );
+
+    unsigned int next = 0;
+    bool ordered = true;
+    for (unsigned int index : optimizedIndices) {
+      if (index > next) ordered = false;
+      if (index == next) ++next;
+    }
+    CHECK( ordered );
+  }
+}
@@ -2,6 +2,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+
 TEST_CASE( "obj_parser", "[unit][parsers]" ) {
   auto [vertices, indices] = ge::ObjParser::parse("../tests/dat/quad.obj");
 
@@ -19,4 +22,42 @@ TEST_CASE( "obj_parser", "[unit][parsers]" ) {
 
   REQUIRE( indices.size() == expectedIndices.size() );
   CHECK( indices == expectedIndices );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "spv_parser", "[unit][parsers]" ) {
+  std::vector<char> code = ge::SPVParser::parse("shaders/shader.vert.spv");
+  ge::MappedFile file = ge::SPVParser::map("shaders/shader.vert.spv");
+
+  REQUIRE( file.size() == code.size() );
+  CHECK( std::equal(code.begin(), code.end(), file.data()) );
+
+  bool caught = false;
+  try {
+    ge::SPVParser::map("../tests/dat/quad.obj");
+  }
+  catch (const std::runtime_error&) {
+    caught = true;
+  }
+  CHECK( caught );
+}
+
+TEST_CASE( "spv_invariant_position", "[unit][parsers]" ) {
+  ge::MappedFile file = ge::SPVParser::map("shaders/shader.vert.spv");
+  std::vector<unsigned int> code = ge::SPVParser::invariantPosition(file.data(), file.size());
+
+  REQUIRE( code.size() * sizeof(unsigned int) > file.size() );
+
+  bool invariant = false;
+  for (unsigned int i = 5; i < code.size(); i += code[i] >> 16) {
+    unsigned int opcode = code[i] & 0xffff;
+    if (opcode == 71 && code[i + 2] == 18) invariant = true;
+    if (opcode == 72 && code[i + 3] == 18) invariant = true;
+  }
+  CHECK( invariant );
+
+  std::vector<unsigned int> again = ge::SPVParser::invariantPosition(
+    reinterpret_cast<const char *>(code.data()),
+    code.size() * sizeof(unsigned int)
+  );
+  CHECK( again == code );
+}
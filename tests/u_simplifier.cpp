@@ -0,0 +1,59 @@
+#include "src/include/simplifier.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+TEST_CASE( "simplifier", "[unit][simplifier]" ) {
+  const unsigned int size = 17;
+
+  std::vector<ge::Vertex> vertices;
+  for (unsigned int y = 0; y < size; ++y) {
+    for (unsigned int x = 0; x < size; ++x) {
+      vertices.emplace_back(ge::Vertex(
+        ge::vec3(static_cast<float>(x), static_cast<float>(y), 0.0f),
+        ge::vec2(0.0f),
+        ge::vec3(0.0f, 0.0f, -1.0f)
+      ));
+    }
+  }
+
+  std::vector<unsigned int> indices;
+  for (unsigned int y = 0; y + 1 < size; ++y) {
+    for (unsigned int x = 0; x + 1 < size; ++x) {
+      unsigned int i = y * size + x;
+      indices.insert(indices.end(), { i, i + 1, i + size + 1, i, i + size + 1, i + size });
+    }
+  }
+
+  auto valid = [&vertices](const std::vector<unsigned int>& lod) {
+    if (lod.size() % 3 != 0) return false;
+
+    for (unsigned int i = 0; i < lod.size(); i += 3) {
+      if (lod[i] >= vertices.size() || lod[i + 1] >= vertices.size() || lod[i + 2] >= vertices.size())
+        return false;
+      if (lod[i] == lod[i + 1] || lod[i + 1] == lod[i + 2] || lod[i] == lod[i + 2])
+        return false;
+    }
+
+    return true;
+  };
+
+  SECTION( "simplify" ) {
+    std::vector<unsigned int> simplified = ge::MeshSimplifier::simplify(vertices, indices, indices.size() / 4, 0.01f);
+
+    CHECK( simplified.size() <= indices.size() / 4 );
+    CHECK( !simplified.empty() );
+    CHECK( valid(simplified) );
+  }
+
+  SECTION( "lods" ) {
+    std::vector<std::vector<unsigned int>> lods = ge::MeshSimplifier::lods(vertices, indices, 3);
+
+    REQUIRE( lods.size() == 2 );
+    CHECK( lods[0].size() < indices.size() );
+    CHECK( lods[1].size() < lods[0].size() );
+    CHECK( valid(lods[0]) );
+    CHECK( valid(lods[1]) );
+  }
+}
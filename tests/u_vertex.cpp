@@ -0,0 +1,44 @@
+#include "src/include/vertex.hpp"
+#include "tests/utility.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE( "compact_vertex", "[unit][vertex]" ) {
+  tests::Random random;
+
+  SECTION( "size" ) {
+    CHECK( ge::Vertex::size(ge::CompactVertices) == 20 );
+    CHECK( ge::Vertex::binding(ge::CompactVertices).stride == 20 );
+  }
+
+  SECTION( "half" ) {
+    for (float value : { 0.0f, 1.0f, -2.75f, 0.5f, 1024.0f }) {
+      CHECK( ge::CompactVertex::fromHalf(ge::CompactVertex::half(value)) == value );
+    }
+
+    float value = random() / 50.0f;
+    CHECK( tests::error(ge::CompactVertex::fromHalf(ge::CompactVertex::half(value)), value) <= 1e-3f );
+  }
+
+  SECTION( "octahedral" ) {
+    ge::vec3 normal = ge::vec3(random(), random(), random()).normalized();
+    ge::vec3 decoded = ge::CompactVertex::fromOctahedral(ge::CompactVertex::octahedral(normal));
+
+    CHECK( tests::error(decoded, normal) <= 1e-3f );
+  }
+
+  SECTION( "pack" ) {
+    std::vector<ge::Vertex> vertices = {
+      {{ -0.5f, -0.5f, 0.0f }, { 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }},
+      {{ 0.5f, 0.5f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }}
+    };
+
+    std::vector<char> packed = ge::Vertex::pack(ge::CompactVertices, vertices);
+    REQUIRE( packed.size() == 2 * sizeof(ge::CompactVertex) );
+
+    const ge::CompactVertex * compact = reinterpret_cast<const ge::CompactVertex *>(packed.data());
+    CHECK( compact[1].position[0] == 0.5f );
+    CHECK( ge::CompactVertex::fromHalf(compact[1].uv[1]) == 1.0f );
+    CHECK( tests::error(ge::CompactVertex::fromOctahedral({ compact[0].normal[0], compact[0].normal[1] }), vertices[0].m_normal) <= 1e-3f );
+  }
+}
@@ -0,0 +1,41 @@
+#include "src/include/workers.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE( "worker_pool", "[unit][workers]" ) {
+  ge::WorkerPool workers(3);
+
+  SECTION( "size" ) {
+    CHECK( workers.size() == 4 );
+  }
+
+  SECTION( "run" ) {
+    for (unsigned int i = 0; i < 16; ++i) {
+      std::atomic<unsigned int> sum = 0;
+      workers.run(100, [&sum](unsigned int index) { sum += index; });
+      CHECK( sum == 4950 );
+    }
+  }
+
+  SECTION( "exception" ) {
+    bool caught = false;
+    try {
+      workers.run(8, [](unsigned int index) {
+        if (index == 5) throw std::runtime_error("groot-engine: task failed");
+      });
+    }
+    catch (const std::runtime_error& e) {
+      caught = true;
+      CHECK( e.what() == std::string("groot-engine: task failed") );
+    }
+    CHECK( caught );
+
+    std::atomic<unsigned int> count = 0;
+    workers.run(8, [&count](unsigned int) { ++count; });
+    CHECK( count == 8 );
+  }
+}